@@ -0,0 +1,102 @@
+#!/bin/bash
+
+# measures the compile-time cost of the metafunctions in benchmark/metafunction.cpp
+# for growing input sizes and prints one csv row per compilation:
+#
+#   case,size,compiler,status,seconds,peak_kb,template_seconds,instantiations
+#
+# status is ok, timeout or killed, a case stops growing after a timeout or a killed compiler,
+# a compile error is a bug rather than a measurement, its diagnostics are shown and the script fails
+# peak_kb needs GNU time, template_seconds comes from GCC -ftime-report and
+# instantiations from Clang -ftime-trace, columns a compiler can't provide are left empty
+#
+# usage: benchmark/compile_time.sh > compile_time.csv
+# the environment variables below override the defaults
+
+cxx=${CXX:-g++}
+limit=${LIMIT:-300}
+sizes=(${SIZES:-16 32 64 128 256 512 1024})
+cases=(${CASES:-stable_sort quick_sort merge_sort heap_sort fast_sort fast_sort_types
+       unique unique_types kmp kmp_types cartesian_product cartesian_product_types permutation edit_distance})
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+src=${root}/benchmark/metafunction.cpp
+tmp=$(mktemp -d)
+trap 'rm -rf ${tmp}' EXIT
+
+flags=(-I ${root}/include -m64 -std=c++2a -fsyntax-only)
+
+if ${cxx} --version | grep -q clang; then
+    clang=1
+    flags+=(-ftime-trace -ftime-trace-granularity=0 -ftime-trace=${tmp}/trace.json)
+else
+    clang=0
+    flags+=(-fconcepts -ftime-report)
+fi
+
+gnu_time=
+if [ -x /usr/bin/time ] && /usr/bin/time -f %M true 2> /dev/null; then
+    gnu_time=/usr/bin/time
+fi
+
+echo case,size,compiler,status,seconds,peak_kb,template_seconds,instantiations
+
+for name in "${cases[@]}"; do
+    for size in "${sizes[@]}"; do
+        rm -f ${tmp}/trace.json
+        cmd=(timeout ${limit} ${cxx} "${flags[@]}" -DCASE=${name} -DSIZE=${size} ${src})
+
+        start=$(date +%s.%N)
+
+        if [ -n "${gnu_time}" ]; then
+            ${gnu_time} -f %M -o ${tmp}/peak "${cmd[@]}" > /dev/null 2> ${tmp}/report
+        else
+            "${cmd[@]}" > /dev/null 2> ${tmp}/report
+        fi
+
+        code=$?
+        stop=$(date +%s.%N)
+
+        case ${code} in
+            0) status=ok ;;
+            124) status=timeout ;;
+            *) status=error ;;
+        esac
+
+        if grep -q 'Killed signal\|out of memory' ${tmp}/report; then
+            status=killed
+        fi
+
+        if [ ${status} = error ]; then
+            echo "${name} failed to compile with SIZE=${size}" >&2
+            grep -m 10 'error' ${tmp}/report >&2
+            exit 1
+        fi
+
+        seconds=$(echo "${start} ${stop}" | awk '{ printf "%.3f", $2 - $1 }')
+
+        peak=
+        if [ -n "${gnu_time}" ]; then
+            peak=$(tail -n 1 ${tmp}/peak | grep -x '[0-9]*')
+        fi
+
+        template=
+        count=
+        if [ ${clang} -eq 1 ]; then
+            if [ -f ${tmp}/trace.json ]; then
+                count=$(grep -o '"name":"Instantiate\(Class\|Function\)"' ${tmp}/trace.json | wc -l)
+                template=$(grep -o '"dur":[0-9]*,"name":"Total Instantiate\(Class\|Function\)"' ${tmp}/trace.json |
+                           awk -F '[:,]' '{ sum += $2 } END { if (NR) printf "%.3f", sum / 1e6 }')
+            fi
+        else
+            # the third number of a row is its wall time
+            template=$(grep '^ *template instantiation *:' ${tmp}/report | grep -o '[0-9.]\+ *(' | sed -n '3s/ *(//p')
+        fi
+
+        echo ${name},${size},$(basename ${cxx}),${status},${seconds},${peak},${template},${count}
+
+        if [ ${status} = timeout -o ${status} = killed ]; then
+            break
+        fi
+    done
+done
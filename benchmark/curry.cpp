@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+// g++ -I include -m64 -std=c++2a -s -Wall -O2 -o /tmp/curry benchmark/curry.cpp -l pthread
+
+#include <chrono>
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include <curry_execution.hpp>
+
+using namespace monster;
+
+template <typename F>
+void measure(const char* name, size_t n, F&& f)
+{
+    volatile long sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != n; ++i)
+         sink = sink + f(i);
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << name << " " << std::chrono::duration<double, std::milli>(stop - start).count() << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1 << 26;
+
+    auto sum = [](long a, long b, long c, long d)
+    {
+        return a * b + c - d;
+    };
+
+    auto bound = curry(sum)(3, 5);
+
+    // warm up
+    measure("direct", n, [&](long i){ return sum(3, 5, i, 1); });
+
+    measure("direct", n, [&](long i){ return sum(3, 5, i, 1); });
+    measure("curry bound prefix", n, [&](long i){ return bound(i, 1); });
+    measure("curry one at a time", n, [&](long i){ return curry(sum)(3)(5)(i)(1); });
+
+    std::vector<long> xs(n);
+    std::iota(xs.begin(), xs.end(), 0);
+
+    auto tail = curry(sum)(3, 5, 1);
+    auto last = [&](const std::vector<long>& ys){ return ys.back(); };
+
+    measure("curry call per element", 1, [&](size_t)
+    {
+        std::vector<long> ys;
+        ys.reserve(xs.size());
+
+        for (auto x : xs)
+             ys.push_back(tail(x));
+
+        return last(ys);
+    });
+
+    thread_pool pool(std::thread::hardware_concurrency());
+
+    measure("curry map_over", 1, [&](size_t){ return last(tail.map_over(xs)); });
+    measure("curry map_over pool", 1, [&](size_t){ return last(tail.map_over(pool, xs)); });
+
+    return 0;
+}
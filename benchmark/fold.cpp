@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+// g++ -I include -m64 -std=c++2a -s -Wall -O2 -l pthread -o /tmp/fold benchmark/fold.cpp
+
+#include <chrono>
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include <hof.hpp>
+
+using namespace monster;
+
+template <typename F>
+void measure(const char* name, F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << name << " " << std::chrono::duration<double, std::milli>(stop - start).count() << " ms, result " << result << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1 << 24;
+
+    std::vector<float> f(n);
+    std::vector<int> i(n);
+
+    for (size_t k = 0; k != n; ++k)
+    {
+         f[k] = (k % 100) * 0.01f;
+         i[k] = k % 1000;
+    }
+
+    measure("accumulate float plus", [&]{ return std::accumulate(f.begin(), f.end(), 0.0f); });
+    measure("foldl float plus", [&]{ return foldl(std::plus<>(), f, 0.0f); });
+    measure("foldl float plus reassociate", [&]{ return foldl(std::plus<>(), f, 0.0f, reassociate); });
+    measure("foldl float max reassociate", [&]{ return foldl(max_op(), f, 0.0f, reassociate); });
+
+    measure("accumulate int plus", [&]{ return std::accumulate(i.begin(), i.end(), 0L); });
+    measure("foldl int plus", [&]{ return foldl(std::plus<>(), i, 0L); });
+    measure("foldl int min", [&]{ return foldl(min_op(), i, 1000); });
+
+    return 0;
+}
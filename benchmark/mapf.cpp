@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+// g++ -I include -m64 -std=c++2a -s -Wall -O2 -l pthread -o /tmp/mapf benchmark/mapf.cpp
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <hof.hpp>
+
+using namespace monster;
+
+// counts the copies of the elements, a copied vector shows up as size() element copies
+struct element
+{
+    static inline size_t copies = 0;
+
+    double value = 0;
+
+    element() = default;
+
+    element(double value) : value(value)
+    {
+    }
+
+    element(const element& other) : value(other.value)
+    {
+        ++copies;
+    }
+
+    element& operator=(const element& other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+
+    element(element&&) = default;
+    element& operator=(element&&) = default;
+};
+
+template <typename F>
+bool measure(const char* name, F&& f)
+{
+    element::copies = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << name << " " << std::chrono::duration<double, std::milli>(stop - start).count() << " ms, "
+              << element::copies << " copies" << std::endl;
+
+    return element::copies == 0;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1 << 24;
+
+    std::vector<element> v(n, element(1.0));
+    std::vector<element> out(n);
+    std::vector<float> floats;
+
+    auto twice = [](element e){ return element(e.value * 2); };
+    auto by_ref = [](const element& e){ return element(e.value * 2); };
+
+    bool ok = true;
+
+    ok &= measure("mapf_in_place", [&]{ mapf_in_place(by_ref, v); });
+    ok &= measure("mapf_into", [&]{ mapf_into(by_ref, v, out.begin()); });
+    ok &= measure("mapf_to", [&]{ floats = mapf_to<float>([](const element& e){ return e.value; }, v); });
+    ok &= measure("mapf rvalue", [&]{ v = mapf(by_ref, std::move(v)); });
+
+    // the baseline copies every element into the by-value parameter of the function
+    measure("mapf by value", [&]{ mapf(twice, v); });
+
+    if (!ok || floats.size() != n || out[n - 1].value != 4 || v[0].value != 8)
+    {
+        std::cerr << "hidden copies detected" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+// a compile-time benchmark, one metafunction applied to an input of SIZE elements:
+// g++ -I include -m64 -std=c++2a -fconcepts -fsyntax-only -DCASE=unique -DSIZE=128 benchmark/metafunction.cpp
+// benchmark/compile_time.sh runs every case over growing sizes and reports the cost as csv
+// without CASE all of them are instantiated at a small SIZE, which is what the cmake target builds
+
+#include <monster.hpp>
+
+#ifndef SIZE
+#define SIZE 16
+#endif
+
+using namespace monster;
+
+// scattered values in [-SIZE / 4, SIZE / 4), each of them shows up twice
+template <typename T>
+struct scatter;
+
+template <size_t... N>
+struct scatter<std::index_sequence<N...>> : std::type_identity<std::integer_sequence<int, int(N * 7919 % SIZE / 2) - SIZE / 4 ...>>
+{
+};
+
+template <size_t n>
+using values = typeof_t<scatter<std::make_index_sequence<n>>>;
+
+using input = values<SIZE>;
+
+// each case is applied to the input only when it is selected
+namespace cases
+{
+    template <typename T>
+    using stable_sort = monster::stable_sort<T>;
+
+    template <typename T>
+    using quick_sort = monster::quick_sort<T>;
+
+    template <typename T>
+    using merge_sort = monster::merge_sort<T>;
+
+    template <typename T>
+    using heap_sort = monster::heap_sort<T>;
+
+    template <typename T>
+    using fast_sort = monster::fast_sort<T>;
+
+    template <typename T>
+    using fast_sort_types = monster::fast_sort<to_tuple_t<T>>;
+
+    template <typename T>
+    using unique = monster::unique<T>;
+
+    template <typename T>
+    using unique_types = monster::unique<to_tuple_t<T>>;
+
+    template <typename T>
+    using kmp = monster::kmp<range_t<SIZE / 2, SIZE / 2 + 4, T>, T>;
+
+    template <typename T>
+    using kmp_types = monster::kmp<to_tuple_t<range_t<SIZE / 2, SIZE / 2 + 4, T>>, to_tuple_t<T>>;
+
+    template <typename T>
+    using cartesian_product = monster::cartesian_product<T, values<4>>;
+
+    template <typename T>
+    using cartesian_product_types = monster::cartesian_product<to_tuple_t<T>, to_tuple_t<values<4>>>;
+
+    template <typename T>
+    using permutation = monster::permutation<T, true>;
+
+    template <typename T>
+    using edit_distance = monster::edit_distance<T, reverse_t<T>>;
+}
+
+template <template <typename> typename... F>
+using run = std::tuple<typeof_t<F<input>>...>;
+
+#ifdef CASE
+using result = run<cases::CASE>;
+#else
+using result = run<cases::stable_sort, cases::quick_sort, cases::merge_sort, cases::heap_sort,
+      cases::fast_sort, cases::fast_sort_types, cases::unique, cases::unique_types, cases::kmp,
+      cases::kmp_types, cases::cartesian_product, cases::cartesian_product_types, cases::permutation,
+      cases::edit_distance>;
+#endif
+
+static_assert(sizeof_t_v<result> > 0);
+
+int main(int argc, char* argv[])
+{
+    return 0;
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+// a compile-time benchmark, time the compilation for different sizes:
+// g++ -I include -m64 -std=c++2a -fconcepts -fsyntax-only -DSIZE=128 benchmark/swap.cpp
+
+#include <monster.hpp>
+
+#ifndef SIZE
+#define SIZE 64
+#endif
+
+using namespace monster;
+
+// reverses T with SIZE / 2 swaps, each one rebuilding the whole list
+template <size_t i, typename T>
+struct swaps : swaps<i - 1, swap_t<i - 1, sizeof_t_v<T> - i, T>>
+{
+};
+
+template <typename T>
+struct swaps<0, T> : std::type_identity<T>
+{
+};
+
+template <size_t i, typename T>
+struct rotates : rotates<i - 1, rotate_t<0, 1, sizeof_t_v<T>, T>>
+{
+};
+
+template <typename T>
+struct rotates<0, T> : std::type_identity<T>
+{
+};
+
+template <size_t i, typename T>
+struct exchanges : exchanges<i - 1, exchange_t<i - 1, index_t<0>, T>>
+{
+};
+
+template <typename T>
+struct exchanges<0, T> : std::type_identity<T>
+{
+};
+
+using values = std::make_index_sequence<SIZE>;
+using types = to_tuple_t<values>;
+
+static_assert(get_v<0, typeof_t<swaps<SIZE / 2, values>>> == SIZE - 1);
+static_assert(get_v<0, typeof_t<rotates<SIZE / 2, values>>> == SIZE / 2);
+static_assert(get_v<SIZE / 2, typeof_t<exchanges<SIZE / 2, values>>> == SIZE / 2);
+
+static_assert(std::is_same_v<element_t<0, typeof_t<swaps<SIZE / 2, types>>>, index_t<SIZE - 1>>);
+static_assert(std::is_same_v<element_t<0, typeof_t<rotates<SIZE / 2, types>>>, index_t<SIZE / 2>>);
+static_assert(std::is_same_v<element_t<0, range_t<SIZE / 2, SIZE, types>>, index_t<SIZE / 2>>);
+
+int main(int argc, char* argv[])
+{
+    return 0;
+}
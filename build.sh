@@ -4,7 +4,7 @@ dst=/tmp
 path=example
 flags=(-I include -m64 -std=c++2a -s -Wall -Os)
 
-for bin in curry tensor object_pool; do
+for bin in object_pool; do
     g++ "${flags[@]}" -o ${dst}/${bin} ${path}/${bin}.cpp
 done
 
@@ -12,6 +12,8 @@ for bin in monster overview; do
     g++ "${flags[@]}" -fconcepts -o ${dst}/${bin} ${path}/${bin}.cpp
 done
 
-g++ "${flags[@]}" -l pthread -o ${dst}/thread_pool ${path}/thread_pool.cpp
+for bin in hof curry tensor memoize thread_pool; do
+    g++ "${flags[@]}" -l pthread -o ${dst}/${bin} ${path}/${bin}.cpp
+done
 
 echo Please check the executables at ${dst}
@@ -7,10 +7,16 @@
 // Official repository: https://github.com/deepgrace/monster
 //
 
-// g++ -I include -m64 -std=c++2a -s -Wall -Os -o /tmp/curry example/curry.cpp
+// g++ -I include -m64 -std=c++2a -s -Wall -Os -o /tmp/curry example/curry.cpp -l pthread
 
+#include <memory>
+#include <vector>
+#include <numeric>
+#include <string>
 #include <cassert>
+#include <functional>
 #include <curry.hpp>
+#include <curry_execution.hpp>
 
 using namespace monster;
 
@@ -53,5 +59,72 @@ int main(int argc, char* argv[])
     assert(t5 == result);
     assert(t6 == result);
 
+    // rvalue curries move their arguments along, so move-only arguments work
+    auto deref = [](std::unique_ptr<int> p, int x){ return *p + x; };
+    auto three = curry(deref)(std::make_unique<int>(1))(2);
+    assert(three == 3);
+
+    // std::ref stores a reference instead of a copy
+    int base = 1;
+    auto add = curry([](int a, int b){ return a + b; }, std::ref(base));
+    base = 10;
+
+    auto twelve = add(2);
+    assert(twelve == 12);
+
+    // folded at compile time, copied like a plain struct, noexcept when the function is
+    constexpr auto add2 = curry([](int a, int b) noexcept { return a + b; })(2);
+    static_assert(add2(3) == 5);
+    static_assert(noexcept(add2(3)));
+    static_assert(std::is_trivially_copyable_v<decltype(add2)>);
+    static_assert(!noexcept(curry(sum)(0)(1, 2, 3, 4, 5)));
+
+    auto push = curry([](std::string& s, char c) -> std::string& { return s += c; });
+    std::string str;
+    push(std::ref(str))('x');
+    assert(str == "x");
+
+    // placeholders pick call arguments by position, the rest are appended
+    using namespace monster::placeholders;
+
+    auto sub = [](int a, int b, int c){ return a - b - c; };
+    auto p0 = partial(sub, _2, 1, _1)(10, 20);
+    auto p1 = partial(sub, 100)(10, 20);
+    auto p2 = partial(sub, _1, 1)(10, 2);
+    assert(p0 == 9 && p1 == 70 && p2 == 7);
+
+    constexpr auto half = partial([](int a, int b){ return a / b; }, _1, 2);
+    static_assert(half(8) == 4);
+    static_assert(std::is_trivially_copyable_v<decltype(half)>);
+
+    auto moved = partial(deref, _1, 2)(std::make_unique<int>(5));
+    auto bound = partial(deref, std::make_unique<int>(6), _1);
+    auto eight = std::move(bound)(2);
+    assert(moved == 7 && eight == 8);
+
+    // completing a temporary curry hands out a copy of what would refer into it
+    auto same = [](const std::string& s, int) -> const std::string& { return s; };
+    auto&& kept = curry(same)(std::string(100, 'x'))(1);
+    assert(kept.size() == 100);
+
+    // a placeholder used twice hands over the same argument twice, without moving from it
+    auto twice = partial([](std::string a, std::string b){ return a + b; }, _1, _1)(std::string("ab"));
+    assert(twice == "abab");
+
+    // the stored arguments are bound once for a whole range
+    std::vector<int> xs(1000);
+    std::iota(xs.begin(), xs.end(), 0);
+
+    auto affine = curry([](int a, int b, int x){ return a * x + b; })(3, 1);
+    auto ys = affine.map_over(xs);
+    assert(ys.size() == xs.size() && ys[999] == 2998);
+
+    thread_pool pool(4);
+    auto zs = affine.map_over(pool, xs);
+    assert(zs == ys);
+
+    auto even = curry([](int m, int x){ return x % m == 0; })(2).map_over(pool, xs);
+    assert(even.size() == xs.size() && even[998] && !even[999]);
+
     return 0;
 }
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+// g++ -I include -m64 -std=c++2a -s -Wall -Os -l pthread -o /tmp/hof example/hof.cpp
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <sstream>
+#include <iterator>
+#include <iostream>
+#include <hof_execution.hpp>
+
+using namespace monster;
+
+int main(int argc, char* argv[])
+{
+    std::vector<int> v(1000);
+    std::iota(v.begin(), v.end(), 1);
+
+    // transforms in place
+    auto w = mapf([](int x){ return x * 2; }, v);
+    assert(v[999] == 2000 && w == v);
+    assert(foldl(std::plus<>(), w, 0) == 1001000);
+
+    // typed functors narrow every step just like std::accumulate
+    std::vector<long long> wide{1LL << 32, 1};
+    std::vector<int> large{40000, 40000};
+    assert(foldl(std::plus<int>(), wide, 0LL) == std::accumulate(wide.begin(), wide.end(), 0LL, std::plus<int>()));
+    assert(foldr(std::plus<short>(), large, 0) == std::accumulate(large.rbegin(), large.rend(), 0, std::plus<short>()));
+
+    std::vector<std::string> s{"a", "b", "c", "d", "e"};
+    assert(foldl(std::plus<>(), s, std::string("<")) == "<abcde");
+    assert(foldr(std::plus<>(), s, std::string("<")) == "<edcba");
+
+    std::vector<double> halves;
+    mapf_into([](int x){ return x / 2.0; }, v, std::back_inserter(halves));
+    // exact for integers, opt-in for floating point
+    std::vector<float> tenths(1000, 0.1f);
+    assert(foldl(min_op(), v, 1 << 30) == 2 && foldr(max_op(), v, 0) == 2000);
+    assert(std::abs(foldl(std::plus<>(), tenths, 0.0f, reassociate) - 100.0f) < 1e-3f);
+
+    std::vector<int> u(v);
+    assert(&mapf_in_place([](int x){ return x / 2; }, u) == &u && u[999] == 1000);
+    assert(mapf_to<std::string>([](int x){ return std::to_string(x); }, u)[9] == "10" && halves[9] == 10);
+
+    thread_pool pool(4);
+
+    mapf(pool, [](int x){ return x + 1; }, v);
+    assert(v[0] == 3 && v[999] == 2001);
+
+    // associative operators are folded as a tree of partial folds on the pool
+    assert(foldl(pool, std::plus<>(), v, 0) == 1002000);
+    assert(foldl(pool, std::plus<>(), s, std::string("<")) == "<abcde");
+    assert(foldr(pool, std::plus<>(), s, std::string("<")) == "<edcba");
+
+    assert(foldl(pool, associative([](int x, int y){ return std::max(x, y); }), v, 0) == 2001);
+
+    // floating point sums stay bit-exact unless reassociation is asked for
+    assert(foldl(pool, std::plus<>(), tenths, 0.0f) == foldl(std::plus<>(), tenths, 0.0f));
+    assert(std::abs(foldl(pool, std::plus<>(), tenths, 0.0f, reassociate) - 100.0f) < 1e-3f);
+
+    // not declared associative, folded sequentially
+    assert(foldl(pool, [](int x, int y){ return x - y; }, std::vector<int>{1, 2, 3}, 10) == 4);
+
+    // nothing is evaluated until foldl or collect consumes the pipeline, in one pass over v
+    auto odd_squares = v | lazy::map([](int x){ return x * x; }) | lazy::filter([](int x){ return x % 2; }) | lazy::take(3);
+    assert(foldl(std::plus<>(), odd_squares, 0) == 9 + 25 + 49);
+    assert(collect(odd_squares) == std::vector<int>({9, 25, 49}));
+
+    auto dot = lazy::zip(v, w) | lazy::map([](auto t){ auto [x, y] = t; return x * y; });
+    assert(foldl(std::plus<>(), dot | lazy::take(2), 0) == 3 * 2 + 5 * 4);
+
+    for (auto [x, y] : lazy::zip(s, w))
+         y = x.size();
+    assert(w[0] == 1 && w[4] == 1 && w[5] == 12);
+
+    // streamed in bounded memory
+    std::istringstream words("x y z");
+    assert(foldl_stream(std::plus<>(), std::istream_iterator<std::string>(words), std::istream_iterator<std::string>(), std::string()) == "xyz");
+
+    std::stringstream records;
+    records.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(int));
+
+    chunk_reader<int> forward(records, 64);
+    assert(foldl_chunks(std::plus<>(), forward, 0) == 1002000);
+
+    records.clear();
+    reverse_chunk_reader<int> backward(records, 64);
+    assert(foldr_chunks([](std::string s, int x){ return s.size() < 8 ? s + std::to_string(x) + " " : s; }, backward, std::string()) == "2001 1999 ");
+
+    std::cout << foldl(pool, std::plus<>(), v, 0) << " " << foldl(std::plus<>(), odd_squares, 0) << " " << foldl(std::plus<>(), dot, 0) << std::endl;
+
+    return 0;
+}
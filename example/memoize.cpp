@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+// g++ -I include -m64 -std=c++2a -s -Wall -Os -l pthread -o /tmp/memoize example/memoize.cpp
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include <iostream>
+#include <curry.hpp>
+#include <memoize.hpp>
+
+using namespace monster;
+
+int main(int argc, char* argv[])
+{
+    std::atomic<int> calls = 0;
+
+    auto slow = [&](int a, const std::string& b, int c)
+    {
+        ++calls;
+        return b + std::to_string(a * c);
+    };
+
+    // at most 2 results are kept, the least recently used one is evicted first
+    auto fast = memoize(slow, 2);
+
+    auto x1 = fast(1, "x", 2);
+    auto x2 = fast(1, "x", 2);
+    assert(x1 == "x2" && x2 == "x2" && calls == 1);
+
+    fast(2, "y", 3);
+    fast(1, "x", 2);
+    fast(3, "z", 4);
+    assert(fast.size() == 2 && calls == 3);
+
+    fast(1, "x", 2);
+    fast(2, "y", 3);
+    assert(calls == 4);
+
+    // a curried memoized function caches on the complete argument list
+    auto prefixed = curry(fast)(7, std::string("p"));
+    auto p1 = prefixed(1);
+    auto p2 = prefixed(1);
+    assert(p1 == "p7" && p2 == "p7" && calls == 5);
+
+    // concurrent callers spread over 8 independently locked shards
+    auto square = memoize<long(long)>([](auto x){ return x * x; }, 4096, 8);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t != 4; ++t)
+         threads.emplace_back([square]
+         {
+             for (long i = 0; i != 10000; ++i)
+                  square(i % 1000);
+         });
+
+    for (auto& thread : threads)
+         thread.join();
+
+    auto last = square(999);
+    assert(square.size() == 1000 && last == 998001);
+
+    std::cout << calls << " " << square.size() << std::endl;
+
+    return 0;
+}
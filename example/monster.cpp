@@ -34,6 +34,18 @@ void execute()
     execute<std::is_same_v<T, U>>();
 }
 
+struct twice
+{
+    template <size_t N>
+    constexpr auto operator()(std::array<int, N> a) const
+    {
+        for (auto& x : a)
+            x *= 2;
+
+        return a;
+    }
+};
+
 int main(int argc, char* argv[])
 {
     execute<hanoi_t<1>, std::integer_sequence<int, 0, 1>>();
@@ -55,6 +67,16 @@ int main(int argc, char* argv[])
             std::integer_sequence<int, -8, 2, -1, 1, 3, 1, 3, 1, 0, -4, 1, 3, 1, 3, 1, -5>>,
             std::index_sequence<>>();
 
+    execute<kmp_t<std::integer_sequence<int, 1, 1>, std::integer_sequence<int, 1, 1, 1, 0, 1, 1>>,
+            std::index_sequence<0, 1, 4>>();
+
+    execute<kmp_t<indexed<std::tuple<double>>, indexed<std::tuple<double, int, int, double>>>, std::index_sequence<0, 3>>();
+    execute<kmp_t<std::tuple<int, int>, std::tuple<int, int, int, char, int, int>>, std::index_sequence<0, 1, 4>>();
+    execute<kmp_t<indexed<std::integer_sequence<int, 1, 1>>, std::integer_sequence<int, 1, 1, 1, 0, 1, 1>>,
+            std::index_sequence<0, 1, 4>>();
+    execute<std::is_base_of_v<kmp<std::integer_sequence<int, 1>, std::integer_sequence<int, 0, 1>>,
+            kmp<indexed<std::integer_sequence<int, 1>>, indexed<std::integer_sequence<int, 0, 1>>>>>();
+
     std::cout << e<double> << std::endl; // 2.71828
     std::cout << pi<double> << std::endl; // 3.14159
 
@@ -85,6 +107,9 @@ int main(int argc, char* argv[])
     execute<contains_v<int, double, char, float, int>>();
     execute<comprise_v<1, -2, 3, 0, 1>>();
 
+    execute<in_type_set_v<char, type_set<int, char, double>>>();
+    execute<!in_type_set_v<float, type_set<int, char, double>>>();
+
     execute<is_unique_type_v<int, double, char, float>>();
     execute<has_duplicates_type_v<int, double, char, int, float>>();
 
@@ -151,6 +176,25 @@ int main(int argc, char* argv[])
     execute<element_t<2, std::integer_sequence<int, 1, -2, 7, 4>>, int_<7>>();
     execute<element_v<3, std::integer_sequence<int, 1, -2, 7, 4>>, 4>();
 
+    // indexing is not recursive, so lengths well beyond -ftemplate-depth are fine
+    execute<get_v<2999, std::make_index_sequence<3000>>, 2999>();
+    execute<element_t<2047, std::make_index_sequence<2048>>, index_t<2047>>();
+
+    using view1 = indexed<std::tuple<char, double, int>>;
+    using view2 = indexed<std::integer_sequence<int, 1, -2, 7, 4>>;
+
+    execute<element_t<1, view1>, double>();
+    execute<element_t<2, view2>, int_<7>>();
+    execute<get_v<1, view2>, -2>();
+    execute<element_t<0, indexed<view1>>, char>();
+    execute<sizeof_t_v<view1>, 3>();
+    execute<sizeof_t_v<view2>, 4>();
+    execute<base_type_t<view1>, std::tuple<>>();
+    execute<typeof_t<view2>, std::integer_sequence<int, 1, -2, 7, 4>>();
+    execute<unindexed_t<indexed<view1>>, std::tuple<char, double, int>>();
+    execute<indexed_t<std::tuple<int>>, indexed<std::tuple<int>>>();
+    execute<indexed_t<int_<1>>, int_<1>>();
+
     execute<front_t<std::tuple<char, double, int>>, char>();
     execute<front_t<std::integer_sequence<int, 1, -2, 7, 4>>, int_<1>>();
     execute<front_v<std::integer_sequence<int, 1, -2, 7, 4>>, 1>();
@@ -300,6 +344,8 @@ int main(int argc, char* argv[])
             std::integer_sequence<int, 1, 5, 4, 2>, int_<0>>, 20>();
 
     execute<accumulate_v<multiplies_t, int_<1>, std::integer_sequence<int, 1, 3, -3, 2>>, -18>();
+    execute<array_apply_t<twice, std::integer_sequence<int, 1, 3, -3, 2>>, std::integer_sequence<int, 2, 6, -6, 4>>();
+    execute<accumulate_v<plus_t, int_<10>, std::integer_sequence<int, 1, 3, -3, 2>, 1, 3>, 10>();
 
     execute<iota_t<succ, int_<-2>, std::integer_sequence<int, 0, 0, 0, 0, 0>>,
             std::integer_sequence<int, -2, -1, 0, 1, 2>>();
@@ -339,10 +385,18 @@ int main(int argc, char* argv[])
     execute<first_type<int, double, char*, float>, int>();
     execute<last_type<int, double, char*, float>, float>();
 
+    execute<decltype([]<size_t... indices>(std::index_sequence<indices...>)
+            {
+                return nth_type_t<2999, index_t<indices>...>();
+            }(std::make_index_sequence<3000>())), index_t<2999>>();
+
+    execute<last_t<int, double, char*, float>, float>();
+
     execute<arg_t<arg<1>, int, float, double>, float>();
 
     execute<make_index_tuple<4>, index_tuple<0, 1, 2, 3>>();
     execute<index_tuple_for<int, char, double>, index_tuple<0, 1, 2>>();
+    execute<make_index_tuple<7>, index_tuple<0, 1, 2, 3, 4, 5, 6>>();
 
     execute<make_index_sequence<4>, index_sequence<0, 1, 2, 3>>();
     execute<index_sequence_for<int, char, double>, index_sequence<0, 1, 2>>();
@@ -359,6 +413,12 @@ int main(int argc, char* argv[])
     execute<concat_t<std::integer_sequence<int, 1, 2, 3>, std::integer_sequence<int, 4, 5, 6>>,
             std::integer_sequence<int, 1, 2, 3, 4, 5, 6>>();
 
+    execute<concat_t<std::tuple<int>, std::tuple<>, std::tuple<char>, std::tuple<float>, std::tuple<int>,
+            std::tuple<>, std::tuple<double>, std::tuple<char>, std::tuple<int, int>, std::tuple<float>>,
+            std::tuple<int, char, float, int, double, char, int, int, float>>();
+    execute<concat_t<std::index_sequence<0>, std::index_sequence<1, 2>, std::index_sequence<3>, std::index_sequence<>,
+            std::index_sequence<4>>, std::index_sequence<0, 1, 2, 3, 4>>();
+
     execute<unique_t<std::tuple<int, char, int, double>> , std::tuple<char, int, double>>();
     execute<unique_t<std::integer_sequence<int, 2, 2, 3, 4, 3>>, std::integer_sequence<int, 2, 4, 3>>();
 
@@ -432,6 +492,12 @@ int main(int argc, char* argv[])
     execute<swap_t<0, 2, std::integer_sequence<int, 1, -2, 7, 4>>,
             std::integer_sequence<int, 7, -2, 1, 4>>();
 
+    execute<pick_t<std::tuple<int, double, char>, std::index_sequence<2, 0, 0>>, std::tuple<char, int, int>>();
+    execute<pick_t<std::integer_sequence<int, 1, -2, 7>, std::index_sequence<1, 2>>,
+            std::integer_sequence<int, -2, 7>>();
+
+    execute<offset_sequence_t<std::index_sequence<0, 1, 2>, 3>, std::index_sequence<3, 4, 5>>();
+
     using ranges_t = swap_ranges<1, 4, std::integer_sequence<int, 0, 1, 2, 3, 4, 5>,
           std::integer_sequence<int, -1, -2, -3, -4, -5>>;
 
@@ -462,6 +528,11 @@ int main(int argc, char* argv[])
 
     execute<within_v<2, -2, 4>>();
     execute<!within_v<5, -2, 4>>();
+    execute<within_v<size_t(0), -2, 4>>();
+    execute<within_v<9999, 0, 10000>>();
+    execute<within_v<'b', 'a', 'z'>>();
+    execute<!within_v<'z', 'a', 'z'>>();
+    execute<within_v<true, false, 2>>();
 
     execute<gsub_t<1, 5, int, float, std::tuple<int, char, int, double, int, float, char>>,
             std::tuple<int, char, float, double, float, float, char>>();
@@ -561,6 +632,10 @@ int main(int argc, char* argv[])
     execute<type_index_v<uint64_t, std::tuple<char, float, double, int, char>>, 5>();
     execute<value_index_v<6, std::integer_sequence<int, 1, -2, 0, 3, 6, 5>>, 4>();
     execute<value_index_v<7, std::integer_sequence<int, 1, -2, 0, 3, 6, 5>>, 6>();
+    execute<type_index_v<char, std::tuple<int, char, double, char>>, 1>();
+    execute<value_index_v<3, std::integer_sequence<int, 3, 1, 3>>, 0>();
+    execute<value_index_v<-1, std::index_sequence<0, 1>>, 2>();
+    execute<value_index_v<1, std::index_sequence<0, 1>>, 1>();
 
     execute<tuple_element_size_v<2, std::tuple<short, int, double>>, sizeof(double)>();
 
@@ -753,6 +828,11 @@ int main(int argc, char* argv[])
     execute<cycle_t<3, int, double>, std::tuple<int, double, int, double, int, double>>();
     execute<cycle_t<3, int_<2>, int_<4>>, std::integer_sequence<int, 2, 4, 2, 4, 2, 4>>();
     execute<cycle_c<3, 2, 4>, std::integer_sequence<int, 2, 4, 2, 4, 2, 4>>();
+    execute<cycle_t<0, int, double>, std::tuple<>>();
+    execute<sizeof_t_v<cycle_c<10000, 1>>, 10000>();
+
+    execute<clamp_t<3, std::integer_sequence<int, 4, 1, 6, 2>>, std::integer_sequence<int, 4, 1, 6>>();
+    execute<clamp_t<0, std::integer_sequence<int, 4, 1>>, std::integer_sequence<int>>();
 
     execute<rotate_t<0, 2, 5, std::tuple<int, char, double, float, int64_t>>,
             std::tuple<double, float, int64_t, int, char>>();
@@ -818,6 +898,8 @@ int main(int argc, char* argv[])
             std::tuple<int, char, int, float, double ,char, double, float>>();
     execute<cartesian_product_t<std::integer_sequence<int, 1, 2>, std::integer_sequence<int, 3, 4, 5>>,
             std::integer_sequence<int, 1, 3, 1, 4, 1, 5, 2, 3, 2, 4, 2, 5>>();
+    execute<cartesian_product_t<indexed<std::tuple<int, double>>, indexed<std::tuple<char, float>>>,
+            std::tuple<int, char, int, float, double ,char, double, float>>();
 
     execute<tokenize_t<19073>, std::integer_sequence<int, 1, 9, 0, 7, 3>>();
     execute<tokenize_t<19073, 100>, std::integer_sequence<int, 1, 90, 73>>();
@@ -826,6 +908,9 @@ int main(int argc, char* argv[])
     execute<large_number_multiplier_t<tokenize_t<975>, tokenize_t<6084>>,
             std::integer_sequence<int, 5, 9, 3, 1, 9, 0, 0>>();
 
+    execute<large_number_multiplier_t<tokenize_t<99>, tokenize_t<99>>, std::integer_sequence<int, 9, 8, 0, 1>>();
+    execute<large_number_multiplier_t<tokenize_t<0>, tokenize_t<7>>, std::integer_sequence<int, 0>>();
+
     execute<prefix_t<std::tuple<int, double>, float, char>,
             std::tuple<float, char, int, float, char, double>>();
     execute<prefix_t<std::integer_sequence<int, 1, 2>, int_<3>, int_<4>>,
@@ -1003,10 +1088,16 @@ int main(int argc, char* argv[])
     /*
     execute<edit_distance_v<std::tuple<char, short, float, int, double, uint64_t>,
             std::tuple<char, double, nullptr_t, short, uint32_t, int, double, uint64_t>>, 3>();
+    */
 
     execute<edit_distance_v<std::integer_sequence<int, 1, 2, 3, 4, 5, 6>,
             std::integer_sequence<int, 1, 5, 8, 2, 0, 4, 5, 6>>, 3>();
-    */
+
+    execute<edit_distance_v<std::integer_sequence<int, 1, 2, 3>, std::integer_sequence<int>>, 3>();
+    execute<edit_distance_v<indexed<std::integer_sequence<int, 1, 2, 3>>, std::integer_sequence<int, 2, 3>>, 1>();
+    execute<std::is_base_of_v<edit_distance<std::integer_sequence<int, 1, 2>, std::integer_sequence<int, 2>>,
+            edit_distance<indexed<std::integer_sequence<int, 1, 2>>, indexed<std::integer_sequence<int, 2>>>>>();
+    execute<binomial_coeff_v<10, 4>, 210>();
 
     execute<binomial_coeff_v<5, 2>, 10>();
 
@@ -1087,6 +1178,16 @@ int main(int argc, char* argv[])
     execute<heap_sort_t<std::tuple<uint64_t, double, float, char, char, double>>,
             std::tuple<char, char, float, double, double, uint64_t>>();
 
+    execute<fast_sort_t<std::tuple<double, uint64_t, double, float, int, char, float, char, double>>,
+            std::tuple<char, char, float, int, float, double, uint64_t, double, double>>();
+
+    execute<fast_sort_t<std::tuple<int, char, double, float>, greater_t>, std::tuple<double, int, float, char>>();
+    execute<fast_sort_t<std::integer_sequence<int, 3, -1, 4, 1, -5>, greater_equal_t>,
+            std::integer_sequence<int, 4, 3, 1, -1, -5>>();
+
+    execute<fast_sort_t<std::tuple<>>, std::tuple<>>();
+    execute<fast_sort_t<std::index_sequence<>>, std::index_sequence<>>();
+
     using input1 = std::integer_sequence<int, 2, 1, 0, -3, 4, 1, -7, 5, -2>;
     using output1 = std::integer_sequence<int, -7, -3, -2, 0, 1, 1, 2, 4, 5>;
     using index1 = std::index_sequence<6, 3, 8, 2, 1, 5, 0, 4, 7>;
@@ -1095,6 +1196,11 @@ int main(int argc, char* argv[])
     execute<select_sort_t<input1>, output1>();
     execute<counting_sort_t<input1>, output1>();
     execute<radix_sort_t<input1>, output1>();
+
+    execute<radix_sort_t<std::integer_sequence<int, 2000000000, -2000000000, 0, 7, -7>>,
+            std::integer_sequence<int, -2000000000, -7, 0, 7, 2000000000>>();
+
+    execute<counting_sort_t<std::integer_sequence<char, 'c', 'a', 'b'>>, std::integer_sequence<char, 'a', 'b', 'c'>>();
     execute<stooge_sort_t<input1>, output1>();
     execute<bubble_sort_t<input1>, output1>();
     execute<shaker_sort_t<input1>, output1>();
@@ -1106,14 +1212,21 @@ int main(int argc, char* argv[])
     execute<insert_sort_t<input1>, output1>();
     execute<insertion_sort_t<input1>, output1>();
     execute<merge_sort_t<input1>, output1>();
+    execute<merge_sort_t<std::integer_sequence<int, 1, 3, 3, 3>>, std::integer_sequence<int, 1, 3, 3, 3>>();
+    execute<merge_sort_t<std::integer_sequence<int, 3, 1, 3, 2, 3>>, std::integer_sequence<int, 1, 2, 3, 3, 3>>();
+
+    using scattered = std::integer_sequence<int, -8, 1, -5, 4, 3, -3, 2, -6, 1, -1, -8, 7, 6, -2, 0, -4,
+                                                 -1, 5, -7, 4, 3, -3, 2, -6, 7, -1, -7, 5, 6, -2, 0, -5>;
+    execute<stable_sort_t<scattered>, fast_sort_t<scattered>>();
     execute<strand_sort_t<input1>, output1>();
     execute<heap_sort_t<input1>, output1>();
+    execute<fast_sort_t<input1>, output1>();
     execute<sort_index_t<input1>, index1>();
 
     execute<sort_v<input1, output1, stable_sort, select_sort, counting_sort,
             radix_sort, stooge_sort, bubble_sort, oddeven_sort, gnome_sort,
             shaker_sort, selection_sort, quick_sort, quick_sort_iterative,
-            insert_sort, insertion_sort, merge_sort, strand_sort, heap_sort>>();
+            insert_sort, insertion_sort, merge_sort, strand_sort, heap_sort, fast_sort>>();
 
     using input2 = std::tuple<double, short, double, int, char, char, double>;
     using output2 = std::tuple<char, char, short, int, double, double, double>;
@@ -1136,12 +1249,13 @@ int main(int argc, char* argv[])
     execute<merge_sort_t<input2>, output2>();
     execute<strand_sort_t<input2>, output2>();
     execute<heap_sort_t<input2>, output2>();
+    execute<fast_sort_t<input2>, output2>();
     execute<sort_index_t<input2>, index2>();
 
     execute<sort_v<input2, output2, stable_sort, select_sort, counting_sort,
             radix_sort, stooge_sort, bubble_sort, oddeven_sort, gnome_sort,
             shaker_sort, selection_sort, quick_sort, quick_sort_iterative,
-            insert_sort, insertion_sort, merge_sort, strand_sort, heap_sort>>();
+            insert_sort, insertion_sort, merge_sort, strand_sort, heap_sort, fast_sort>>();
 
     return 0;
 }
@@ -7,10 +7,17 @@
 // Official repository: https://github.com/deepgrace/monster
 //
 
-// g++ -I include -m64 -std=c++2a -s -Wall -Os -o /tmp/tensor example/tensor.cpp
+// g++ -I include -m64 -std=c++2a -s -Wall -Os -l pthread -o /tmp/tensor example/tensor.cpp
 
+#include <cassert>
+#include <filesystem>
+#include <sstream>
 #include <iostream>
-#include <tensor.hpp>
+#include <arena.hpp>
+#include <tensor_io.hpp>
+#include <memory_resource>
+#include <sparse_tensor.hpp>
+#include <tensor_parallel.hpp>
 
 using namespace monster;
 
@@ -23,5 +30,211 @@ int main(int argc, char* argv[])
 
     std::cout << t[2][1][0] << std::endl;
 
+    tensor<int, 3> a(4);
+    tensor<int, 3> b(4);
+    tensor<int, 3> c(4);
+
+    for (size_t i = 0; i != 4; ++i)
+    {
+        for (size_t j = 0; j != 4; ++j)
+        {
+            for (size_t k = 0; k != 4; ++k)
+            {
+                a[i][j][k] = i;
+                b[i][j][k] = j;
+                c[i][j][k] = k;
+            }
+        }
+    }
+
+    // evaluated in a single pass, no intermediate tensor is created
+    tensor<int, 3> d = a + b * c - 1;
+    assert(d.size() == 4);
+    assert(d[3][2][1] == 3 + 2 * 1 - 1);
+
+    d = -(d + d) / 2;
+    assert(d[3][2][1] == -4);
+
+    d += 2 * a;
+    assert(d[3][2][1] == 2);
+
+    // a scalar is promoted with the elements, operands of different extents are rejected
+    tensor<int, 1> odd(2);
+    odd[0] = 3;
+    odd[1] = 5;
+
+    tensor<double, 1> halves = odd * 0.5;
+    assert(halves[0] == 1.5 && halves[1] == 2.5);
+
+    std::string mismatch;
+    try
+    {
+        tensor<int, 1> sum = odd + tensor<int, 1>(8);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        mismatch = e.what();
+    }
+    assert(mismatch.find("extent mismatch") != std::string::npos);
+
+    // round trip through the binary format
+    std::stringstream ss;
+    tensor_save(d, ss);
+
+    tensor<int, 3> e;
+    tensor_load(e, ss);
+    assert(e.size() == 4 && e[3][2][1] == 2);
+
+    // stream a tensor larger than the working buffer in chunks
+    std::string path = "/tmp/monster_tensor.bin";
+    {
+        std::ofstream os(path, std::ios::binary);
+        tensor_writer<float, 2> writer(os, {1000, 1000});
+
+        std::vector<float> chunk(4096);
+        for (size_t n = 0; writer.remaining(); n += chunk.size())
+        {
+             size_t count = std::min(chunk.size(), writer.remaining());
+             for (size_t i = 0; i != count; ++i)
+                  chunk[i] = n + i;
+             writer.write(chunk.data(), count);
+        }
+    }
+
+    // zero-copy, read-only view of the file contents
+    mapped_tensor<float, 2> m(path);
+    assert(m.size() == 1000 && m[12][34] == 12034);
+
+    tensor<float, 2> f = m.view() * 2;
+    assert(f[999][999] == 2 * 999999);
+
+    // an empty or cut short file is rejected before any element is read
+    for (size_t keep : {size_t(4096), size_t(0)})
+    {
+        std::filesystem::resize_file(path, keep);
+
+        std::string error;
+        try
+        {
+            mapped_tensor<float, 2> cut(path);
+        }
+        catch (const std::runtime_error& e)
+        {
+            error = e.what();
+        }
+        assert(error.find(keep ? "truncated" : "empty") != std::string::npos);
+    }
+
+    std::remove(path.c_str());
+
+    // a crafted shape whose element count wraps is rejected while parsing the header
+    std::stringstream crafted;
+    tensor_header<float, 2>({1, 1}).write(crafted);
+
+    auto bytes = crafted.str();
+    uint64_t shape[] = {uint64_t(1) << 63, 2};
+    std::memcpy(bytes.data() + tensor_header<float, 2>::prefix, shape, sizeof(shape));
+
+    std::string overflow;
+    try
+    {
+        tensor_header<float, 2>::parse(bytes.data(), bytes.size());
+    }
+    catch (const std::runtime_error& e)
+    {
+        overflow = e.what();
+    }
+    assert(overflow.find("overflow") != std::string::npos);
+
+    // SIMD friendly rows
+    tensor<float, 2, aligned_allocator<float, 64>> g(16);
+    assert(reinterpret_cast<uintptr_t>(g[5].data()) % 64 == 0);
+
+    // temporaries of one request come from a bump arena and are freed in one shot
+    arena scratch;
+    {
+        arena_allocator<int> alloc(scratch);
+        tensor<int, 3, arena_allocator<int>> h(a + b, alloc);
+
+        h += c;
+        assert(h[1][2][3] == 6);
+        assert(h.get_allocator() == alloc && scratch.used() > 0);
+    }
+    scratch.release();
+    assert(scratch.used() == 0);
+
+    // any std::pmr memory resource works as well
+    std::pmr::monotonic_buffer_resource pool;
+    tensor<int, 3, std::pmr::polymorphic_allocator<int>> p(a * 2, &pool);
+    assert(p[3][0][0] == 6 && p[3].get_allocator().resource() == &pool);
+
+    // the outermost dimension is split across the workers of the pool
+    thread_pool workers(4);
+
+    tensor<double, 3> q(0);
+    parallel_resize(workers, q, 64);
+    parallel_fill(workers, q, 0.5);
+    assert(parallel_reduce(workers, q, 0.0) == 64 * 64 * 64 * 0.5);
+
+    parallel_transform(workers, q, [](double x){ return x * 4; });
+    parallel_transform(workers, a + b, p, [](int x){ return x + 1; });
+    assert(q[63][63][63] == 2 && p[3][2][1] == 6);
+
+    // the monotonic resource isn't synchronized, so the pmr tensor is resized on this thread
+    static_assert(!is_concurrent_allocator_v<std::pmr::polymorphic_allocator<int>>);
+    parallel_resize(workers, p, 16);
+    assert(p.size() == 16 && p[15].size() == 16);
+
+    assert(parallel_reduce(workers, a + c, 0, [](int x, int y){ return std::max(x, y); }) == 6);
+
+    // only the non-zeros are stored
+    coo_tensor<int, 3> coo(1000);
+    coo.insert({999, 0, 7}, 3);
+    coo.insert({1, 2, 3}, 2);
+    coo.insert({999, 0, 7}, 1);
+
+    csf_tensor<int, 3> csf(coo);
+    assert(csf.nnz() == 2);
+
+    size_t visited = 0;
+    csf.for_each([&](auto& c, int v){ visited += c[0] * v; });
+    assert(visited == 999 * 4 + 1 * 2);
+
+    tensor<int, 1> x(1000);
+    x[7] = 5;
+    assert((csf * x)[999][0] == 20);
+
+    tensor<int, 2> w(4);
+    w[0][1] = 2;
+    w[3][0] = 1;
+
+    csr_tensor<int> csr(w);
+    auto ww = csr * w;
+    assert(csr.nnz() == 2 && ww[3][1] == 2 && csr.to_dense()[0][1] == 2);
+
+    // operands of different dimensions and coordinates outside the extent are rejected
+    size_t rejected = 0;
+    for (auto product : {+[](const csr_tensor<int>& m){ m * tensor<int, 1>(3); }, +[](const csr_tensor<int>& m){ m * tensor<int, 2>(5); }})
+    {
+         try
+         {
+             product(csr);
+         }
+         catch (const std::invalid_argument&)
+         {
+             ++rejected;
+         }
+    }
+
+    try
+    {
+        coo.insert({1000, 0, 0}, 1);
+    }
+    catch (const std::out_of_range&)
+    {
+        ++rejected;
+    }
+    assert(rejected == 3 && coo.nnz() == 3);
+
     return 0;
 }
@@ -9,6 +9,8 @@
 
 // g++ -I include -m64 -std=c++2a -s -Wall -Os -l pthread -o /tmp/thread_pool example/thread_pool.cpp
 
+#include <latch>
+#include <thread>
 #include <vector>
 #include <iostream>
 #include <thread_pool.hpp>
@@ -35,5 +37,31 @@ int main(int argc, char* argv[])
         std::cout << result.get() << " ";
     std::cout << std::endl;
 
+    // every worker calls parallel_for on its own pool, the nested loops run inline instead of deadlocking
+    std::vector<std::future<void>> nested;
+    std::vector<int> squares(16);
+    std::latch busy(4);
+
+    for (int i = 0; i != 4; ++i)
+         nested.emplace_back(pools.post([&, i]
+         {
+             busy.arrive_and_wait();
+             pools.parallel_for(4 * i, 4 * i + 4, [&](size_t j){ squares[j] = j * j; });
+         }));
+
+    for (auto&& n : nested)
+        n.get();
+
+    for (auto&& square : squares)
+        std::cout << square << " ";
+    std::cout << std::endl;
+
+    // block b of every call runs on worker b, so each thread keeps touching the same part of the data
+    std::vector<std::thread::id> first(16), second(16);
+    pools.parallel_for(0, 16, [&](size_t i){ first[i] = std::this_thread::get_id(); });
+    pools.parallel_for(0, 16, [&](size_t i){ second[i] = std::this_thread::get_id(); });
+
+    std::cout << std::boolalpha << (first == second) << std::endl;
+
     return 0;
 }
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+namespace monster
+{
+    // allocates every object on an Align byte boundary, e.g. a cache line or a SIMD register width
+    template <typename T, size_t Align = 64>
+    class aligned_allocator
+    {
+        public:
+            using value_type = T;
+            static constexpr size_t alignment = std::max(Align, alignof(T));
+
+            template <typename U>
+            struct rebind
+            {
+                using other = aligned_allocator<U, Align>;
+            };
+
+            aligned_allocator() = default;
+
+            template <typename U>
+            aligned_allocator(const aligned_allocator<U, Align>&) noexcept
+            {
+            }
+
+            T* allocate(size_t n)
+            {
+                return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+            }
+
+            void deallocate(T* p, size_t n) noexcept
+            {
+                ::operator delete(p, n * sizeof(T), std::align_val_t(alignment));
+            }
+
+            template <typename U>
+            bool operator==(const aligned_allocator<U, Align>&) const noexcept
+            {
+                return true;
+            }
+    };
+
+    // a bump allocator, individual deallocations are no-ops and release() frees everything at once,
+    // it is not synchronized, threads that allocate concurrently need an arena each
+    class arena
+    {
+        public:
+            explicit arena(size_t block_size = 1 << 20);
+
+            arena(const arena&) = delete;
+            arena& operator=(const arena&) = delete;
+
+            void* allocate(size_t bytes, size_t align);
+            void release();
+
+            size_t used() const
+            {
+                return bytes;
+            }
+
+            virtual ~arena();
+
+        private:
+            void grow(size_t size);
+
+            size_t block_size;
+            size_t bytes = 0;
+            size_t left = 0;
+
+            std::byte* cur = nullptr;
+            std::vector<std::pair<std::byte*, size_t>> blocks;
+    };
+
+    inline arena::arena(size_t block_size) : block_size(block_size)
+    {
+    }
+
+    inline void* arena::allocate(size_t size, size_t align)
+    {
+        void* p = cur;
+        if (!std::align(align, size, p, left))
+        {
+            grow(size + align);
+            p = cur;
+            std::align(align, size, p, left);
+        }
+
+        cur = static_cast<std::byte*>(p) + size;
+        left -= size;
+        bytes += size;
+
+        return p;
+    }
+
+    inline void arena::grow(size_t size)
+    {
+        size = std::max(size, block_size);
+
+        cur = static_cast<std::byte*>(::operator new(size));
+        left = size;
+
+        blocks.emplace_back(cur, size);
+    }
+
+    inline void arena::release()
+    {
+        if (blocks.empty())
+            return;
+
+        // keep the first block so the next round of allocations doesn't hit the system allocator
+        for (size_t i = 1; i != blocks.size(); ++i)
+             ::operator delete(blocks[i].first, blocks[i].second);
+
+        blocks.resize(1);
+        cur = blocks[0].first;
+        left = blocks[0].second;
+        bytes = 0;
+    }
+
+    inline arena::~arena()
+    {
+        for (auto& [p, size] : blocks)
+             ::operator delete(p, size);
+    }
+
+    template <typename T, size_t Align = alignof(T)>
+    class arena_allocator
+    {
+        public:
+            using value_type = T;
+            static constexpr size_t alignment = std::max(Align, alignof(T));
+
+            template <typename U>
+            struct rebind
+            {
+                using other = arena_allocator<U, Align>;
+            };
+
+            arena_allocator(arena& a) noexcept : a(&a)
+            {
+            }
+
+            template <typename U>
+            arena_allocator(const arena_allocator<U, Align>& other) noexcept : a(other.resource())
+            {
+            }
+
+            T* allocate(size_t n)
+            {
+                return static_cast<T*>(a->allocate(n * sizeof(T), alignment));
+            }
+
+            void deallocate(T*, size_t) noexcept
+            {
+            }
+
+            arena* resource() const noexcept
+            {
+                return a;
+            }
+
+            template <typename U>
+            bool operator==(const arena_allocator<U, Align>& other) const noexcept
+            {
+                return a == other.resource();
+            }
+
+        private:
+            arena* a;
+    };
+}
+
+#endif
@@ -11,46 +11,328 @@
 #define CURRIED_HPP
 
 #include <tuple>
+#include <vector>
+#include <ranges>
 #include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
     
 namespace monster
 {
+    class thread_pool;
+
+    // arguments are stored by value, std::ref and std::cref store a reference which is unwrapped for the call
+    template <typename T>
+    using curry_arg_t = std::conditional_t<std::is_same_v<std::unwrap_reference_t<std::remove_cvref_t<T>>, std::remove_cvref_t<T>>,
+                                           T, std::unwrap_reference_t<std::remove_cvref_t<T>>&>;
+
+    template <typename T>
+    constexpr decltype(auto) curry_arg(T&& t) noexcept
+    {
+        if constexpr(std::is_same_v<std::unwrap_reference_t<std::remove_cvref_t<T>>, std::remove_cvref_t<T>>)
+            return std::forward<T>(t);
+        else
+            return t.get();
+    }
+
+    // a const lvalue for lvalue owners, an rvalue otherwise
+    template <typename Self, typename T>
+    using curry_like_t = std::conditional_t<std::is_lvalue_reference_v<Self>, const T&, T&&>;
+
+    // the result of completing an rvalue curry may refer to its stored function or arguments, which die with it,
+    // so such a result is returned by value, only references to non-const objects, as std::ref binds, pass through
+    template <typename Self, typename R>
+    using curry_result_t = std::conditional_t<!std::is_lvalue_reference_v<Self> && (std::is_rvalue_reference_v<R> ||
+                                              std::is_const_v<std::remove_reference_t<R>>), std::remove_cvref_t<R>, R>;
+
+    template <size_t I, typename T>
+    struct curry_leaf
+    {
+        [[no_unique_address]] T value;
+    };
+
+    // unlike std::tuple, the storage is trivially copyable whenever all of the arguments are
+    template <typename S, typename... Args>
+    struct curry_storage;
+
+    template <size_t... I, typename... Args>
+    struct curry_storage<std::index_sequence<I...>, Args...> : curry_leaf<I, Args>...
+    {
+        constexpr curry_storage(Args... args) noexcept((std::is_nothrow_move_constructible_v<Args> && ...)) :
+        curry_leaf<I, Args>{std::move(args)}...
+        {
+        }
+
+        template <typename F>
+        constexpr decltype(auto) apply(F&& f) const&
+        {
+            return std::forward<F>(f)(static_cast<const curry_leaf<I, Args>&>(*this).value...);
+        }
+
+        template <typename F>
+        constexpr decltype(auto) apply(F&& f) &&
+        {
+            return std::forward<F>(f)(std::move(static_cast<curry_leaf<I, Args>&>(*this).value)...);
+        }
+    };
+
     template <typename F, typename... Args>
     class curry
     {
         public:
             using tuple_t = std::tuple<std::decay_t<Args>...>;
 
-            curry(F func, Args... args) : func(func), args(to_tuple(std::move(args)...))
+            constexpr curry(F func, Args... args) noexcept(is_nothrow_movable) : func(std::move(func)), args(std::move(args)...)
             {
             }
 
-            curry(F func, std::tuple<Args...> args) : func(func), args(std::move(args))
+            constexpr curry(F func, std::tuple<Args...> args) noexcept(is_nothrow_movable) :
+            func(std::move(func)), args(std::make_from_tuple<storage_t>(std::move(args)))
             {
             }
 
             template <typename... T>
-            auto operator()(T&&... t) const
-            {
-                auto tuples = std::tuple_cat(args, to_tuple(std::forward<T>(t)...));
-        
-                if constexpr(std::is_invocable_v<F, Args..., T...>)
-                   return std::apply(func, tuples);
-                else
-                   return curry<F, Args..., T...>(func, tuples);
-            }
+            constexpr decltype(auto) operator()(T&&... t) const& noexcept(is_nothrow_call<const curry&, T...>());
+
+            // an rvalue curry moves its function and arguments into the call or the next curry
+            template <typename... T>
+            constexpr decltype(auto) operator()(T&&... t) && noexcept(is_nothrow_call<curry&&, T...>());
+
+            // completes the call with each element of the range in turn, the results are collected into a std::vector
+            template <std::ranges::input_range R>
+            auto map_over(R&& r) const;
+
+            // the results are default constructed first, then assigned by the workers of the pool,
+            // defined in curry_execution.hpp
+            template <std::ranges::random_access_range R>
+            auto map_over(thread_pool& pool, R&& r) const requires std::ranges::sized_range<R>;
 
         private:
+            template <typename, typename...>
+            friend class curry;
 
-            template <typename... T>
-            static auto to_tuple(T&&... t)
+            template <typename R>
+            using element_result_t = std::decay_t<std::invoke_result_t<const F&, curry_arg_t<const Args&>..., std::ranges::range_reference_t<R>>>;
+
+            using storage_t = curry_storage<std::index_sequence_for<Args...>, Args...>;
+
+            static constexpr bool is_nothrow_movable = std::is_nothrow_move_constructible_v<F> &&
+                                                       (std::is_nothrow_move_constructible_v<Args> && ...);
+
+            template <typename Self, typename... T>
+            static constexpr bool is_complete = std::is_invocable_v<curry_like_t<Self, F>, curry_arg_t<curry_like_t<Self, Args>>..., T...>;
+
+            template <typename Self, typename... T>
+            static constexpr bool is_nothrow_call();
+
+            template <typename Self, typename... T>
+            static constexpr decltype(auto) call(Self&& self, T&&... t);
+
+            [[no_unique_address]] F func;
+            [[no_unique_address]] storage_t args;
+    };
+
+    template <typename F, typename... Args>
+    template <typename Self, typename... T>
+    constexpr bool curry<F, Args...>::is_nothrow_call()
+    {
+        if constexpr(is_complete<Self, T...>)
+        {
+            using result_t = std::invoke_result_t<curry_like_t<Self, F>, curry_arg_t<curry_like_t<Self, Args>>..., T...>;
+
+            return std::is_nothrow_invocable_v<curry_like_t<Self, F>, curry_arg_t<curry_like_t<Self, Args>>..., T...> &&
+                   std::is_nothrow_constructible_v<curry_result_t<Self, result_t>, result_t>;
+        }
+        else
+            return std::is_nothrow_constructible_v<F, curry_like_t<Self, F>> &&
+                   (std::is_nothrow_constructible_v<Args, curry_like_t<Self, Args>> && ...) &&
+                   (std::is_nothrow_constructible_v<std::decay_t<T>, T> && ...) &&
+                   curry<F, Args..., std::decay_t<T>...>::is_nothrow_movable;
+    }
+
+    template <typename F, typename... Args>
+    template <typename Self, typename... T>
+    constexpr decltype(auto) curry<F, Args...>::call(Self&& self, T&&... t)
+    {
+        using func_t = curry_like_t<Self, F>;
+
+        if constexpr(is_complete<Self, T...>)
+        {
+            using result_t = std::invoke_result_t<func_t, curry_arg_t<curry_like_t<Self, Args>>..., T...>;
+
+            return std::forward<Self>(self).args.apply([&](auto&&... a) -> curry_result_t<Self, result_t>
+            {
+                return std::invoke(static_cast<func_t>(self.func), curry_arg(std::forward<decltype(a)>(a))..., std::forward<T>(t)...);
+            });
+        }
+        else
+            return std::forward<Self>(self).args.apply([&](auto&&... a)
             {
-                return std::tuple<std::decay_t<T>...>(std::forward<T>(t)...);
+                return curry<F, Args..., std::decay_t<T>...>(static_cast<func_t>(self.func), std::forward<decltype(a)>(a)..., std::forward<T>(t)...);
+            });
+    }
+
+    template <typename F, typename... Args>
+    template <typename... T>
+    constexpr decltype(auto) curry<F, Args...>::operator()(T&&... t) const& noexcept(is_nothrow_call<const curry&, T...>())
+    {
+        return call(*this, std::forward<T>(t)...);
+    }
+
+    template <typename F, typename... Args>
+    template <typename... T>
+    constexpr decltype(auto) curry<F, Args...>::operator()(T&&... t) && noexcept(is_nothrow_call<curry&&, T...>())
+    {
+        return call(std::move(*this), std::forward<T>(t)...);
+    }
+
+    template <typename F, typename... Args>
+    template <std::ranges::input_range R>
+    auto curry<F, Args...>::map_over(R&& r) const
+    {
+        static_assert(is_complete<const curry&, std::ranges::range_reference_t<R>>, "each element must complete the call");
+
+        using result_t = element_result_t<R>;
+
+        return args.apply([&](const auto&... a)
+        {
+            if constexpr(std::is_void_v<result_t>)
+            {
+                for (auto&& e : r)
+                     std::invoke(func, curry_arg(a)..., std::forward<decltype(e)>(e));
             }
+            else
+            {
+                std::vector<result_t> results;
 
-            F func;
-            std::tuple<Args...> args;
+                if constexpr(std::ranges::sized_range<R>)
+                    results.reserve(std::ranges::size(r));
+
+                for (auto&& e : r)
+                     results.push_back(std::invoke(func, curry_arg(a)..., std::forward<decltype(e)>(e)));
+
+                return results;
+            }
+        });
+    }
+
+    template <size_t N>
+    struct placeholder : std::integral_constant<size_t, N>
+    {
+    };
+
+    template <typename T>
+    struct placeholder_index : std::integral_constant<size_t, 0>
+    {
+    };
+
+    template <size_t N>
+    struct placeholder_index<placeholder<N>> : std::integral_constant<size_t, N>
+    {
+    };
+
+    template <typename T>
+    inline constexpr size_t placeholder_index_v = placeholder_index<std::remove_cvref_t<T>>::value;
+
+    namespace placeholders
+    {
+        inline constexpr placeholder<1> _1;
+        inline constexpr placeholder<2> _2;
+        inline constexpr placeholder<3> _3;
+        inline constexpr placeholder<4> _4;
+        inline constexpr placeholder<5> _5;
+        inline constexpr placeholder<6> _6;
+        inline constexpr placeholder<7> _7;
+        inline constexpr placeholder<8> _8;
+        inline constexpr placeholder<9> _9;
+    }
+
+    // binds all of its arguments in one step, placeholder _N takes the N-th call argument,
+    // the call arguments after the last placeholder used are appended in order
+    template <typename F, typename... Args>
+    class partial_function
+    {
+        public:
+            // the number of call arguments taken by placeholders
+            static constexpr size_t bound = std::max({size_t(0), placeholder_index_v<Args>...});
+
+            constexpr partial_function(F func, Args... args) noexcept(is_nothrow_movable) : func(std::move(func)), args(std::move(args)...)
+            {
+            }
+
+            template <typename... T>
+            constexpr decltype(auto) operator()(T&&... t) const& requires (sizeof...(T) >= bound);
+
+            template <typename... T>
+            constexpr decltype(auto) operator()(T&&... t) && requires (sizeof...(T) >= bound);
+
+        private:
+            using storage_t = curry_storage<std::index_sequence_for<Args...>, Args...>;
+
+            static constexpr bool is_nothrow_movable = std::is_nothrow_move_constructible_v<F> &&
+                                                       (std::is_nothrow_move_constructible_v<Args> && ...);
+
+            template <typename A, typename Refs>
+            static constexpr decltype(auto) select(A&& a, Refs& refs) noexcept;
+
+            template <typename Self, typename... T>
+            static constexpr decltype(auto) call(Self&& self, T&&... t);
+
+            [[no_unique_address]] F func;
+            [[no_unique_address]] storage_t args;
     };
+
+    template <typename F, typename... Args>
+    template <typename A, typename Refs>
+    constexpr decltype(auto) partial_function<F, Args...>::select(A&& a, Refs& refs) noexcept
+    {
+        // a call argument taken by several placeholders is passed as an lvalue, so it is never moved from twice
+        if constexpr(constexpr size_t N = placeholder_index_v<A>; N > 0 && ((placeholder_index_v<Args> == N) + ...) > 1)
+            return std::get<N - 1>(refs);
+        else if constexpr(N > 0)
+            return std::get<N - 1>(std::move(refs));
+        else
+            return curry_arg(std::forward<A>(a));
+    }
+
+    template <typename F, typename... Args>
+    template <typename Self, typename... T>
+    constexpr decltype(auto) partial_function<F, Args...>::call(Self&& self, T&&... t)
+    {
+        using func_t = curry_like_t<Self, F>;
+
+        auto refs = std::forward_as_tuple(std::forward<T>(t)...);
+
+        return std::forward<Self>(self).args.apply([&](auto&&... a) -> decltype(auto)
+        {
+            return [&]<size_t... I>(std::index_sequence<I...>) -> decltype(auto)
+            {
+                return std::invoke(static_cast<func_t>(self.func), select(std::forward<decltype(a)>(a), refs)...,
+                                   std::get<bound + I>(std::move(refs))...);
+            }(std::make_index_sequence<sizeof...(T) - bound>());
+        });
+    }
+
+    template <typename F, typename... Args>
+    template <typename... T>
+    constexpr decltype(auto) partial_function<F, Args...>::operator()(T&&... t) const& requires (sizeof...(T) >= bound)
+    {
+        return call(*this, std::forward<T>(t)...);
+    }
+
+    template <typename F, typename... Args>
+    template <typename... T>
+    constexpr decltype(auto) partial_function<F, Args...>::operator()(T&&... t) && requires (sizeof...(T) >= bound)
+    {
+        return call(std::move(*this), std::forward<T>(t)...);
+    }
+
+    template <typename F, typename... Args>
+    constexpr auto partial(F&& f, Args&&... args)
+    {
+        return partial_function<std::decay_t<F>, std::decay_t<Args>...>(std::forward<F>(f), std::forward<Args>(args)...);
+    }
 }
     
 #endif
@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+#ifndef CURRY_EXECUTION_HPP
+#define CURRY_EXECUTION_HPP
+
+#include "curry.hpp"
+#include "thread_pool.hpp"
+
+// The thread_pool overload of curry::map_over, kept apart from curry.hpp so that sequential users need no threads.
+
+namespace monster
+{
+    template <typename F, typename... Args>
+    template <std::ranges::random_access_range R>
+    auto curry<F, Args...>::map_over(thread_pool& pool, R&& r) const requires std::ranges::sized_range<R>
+    {
+        static_assert(is_complete<const curry&, std::ranges::range_reference_t<R>>, "each element must complete the call");
+
+        using result_t = element_result_t<R>;
+
+        auto first = std::ranges::begin(r);
+        size_t size = std::ranges::size(r);
+
+        return args.apply([&](const auto&... a)
+        {
+            auto call = [&](size_t i) -> decltype(auto)
+            {
+                return std::invoke(func, curry_arg(a)..., first[i]);
+            };
+
+            if constexpr(std::is_void_v<result_t>)
+                pool.parallel_for(0, size, call);
+            else if constexpr(std::is_same_v<result_t, bool>)
+            {
+                // std::vector<bool> packs bits, so neighbouring workers can't write to it concurrently
+                std::vector<char> results(size);
+                pool.parallel_for(0, size, [&](size_t i){ results[i] = call(i); });
+
+                return std::vector<bool>(results.begin(), results.end());
+            }
+            else
+            {
+                std::vector<result_t> results(size);
+                pool.parallel_for(0, size, [&](size_t i){ results[i] = call(i); });
+
+                return results;
+            }
+        });
+    }
+}
+
+#endif
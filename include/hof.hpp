@@ -10,11 +10,214 @@
 #ifndef HOF_HPP
 #define HOF_HPP
 
-#include <algorithm>
+#include <span>
+#include <tuple>
+#include <vector>
+#include <istream>
+#include <stdexcept>
+#include <ranges>
+#include <utility>
+#include <iterator>
 #include <numeric>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
 
 namespace monster
 {
+    // operators whose applications may be regrouped, parallel folds split them into a tree of partial folds,
+    // any other operator is folded sequentially
+    template <typename F>
+    struct is_associative : std::false_type
+    {
+    };
+
+    template <typename F>
+    inline constexpr auto is_associative_v = is_associative<std::remove_cvref_t<F>>::value;
+
+    template <typename T>
+    struct is_associative<std::plus<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_associative<std::multiplies<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_associative<std::logical_and<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_associative<std::logical_or<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_associative<std::bit_and<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_associative<std::bit_or<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_associative<std::bit_xor<T>> : std::true_type
+    {
+    };
+
+    struct min_op
+    {
+        template <typename T, typename U>
+        constexpr std::common_type_t<T, U> operator()(const T& t, const U& u) const
+        {
+            return u < t ? u : t;
+        }
+    };
+
+    struct max_op
+    {
+        template <typename T, typename U>
+        constexpr std::common_type_t<T, U> operator()(const T& t, const U& u) const
+        {
+            return t < u ? u : t;
+        }
+    };
+
+    template <>
+    struct is_associative<min_op> : std::true_type
+    {
+    };
+
+    template <>
+    struct is_associative<max_op> : std::true_type
+    {
+    };
+
+    // commutative and associative operators, folds over contiguous arithmetic ranges run them on several
+    // independent accumulators, which breaks the dependency chain of a strict left to right evaluation
+    template <typename F>
+    struct is_reassociable : std::false_type
+    {
+    };
+
+    template <typename F>
+    inline constexpr auto is_reassociable_v = is_reassociable<std::remove_cvref_t<F>>::value;
+
+    template <typename T>
+    struct is_reassociable<std::plus<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_reassociable<std::multiplies<T>> : std::true_type
+    {
+    };
+
+    template <>
+    struct is_reassociable<min_op> : std::true_type
+    {
+    };
+
+    template <>
+    struct is_reassociable<max_op> : std::true_type
+    {
+    };
+
+    // opts a floating point fold into reassociation, trading bit-exact results for speed
+    struct reassociate_t
+    {
+        explicit reassociate_t() = default;
+    };
+
+    inline constexpr reassociate_t reassociate{};
+
+    template <typename F>
+    inline constexpr auto is_rounding_v = false;
+
+    template <typename T>
+    inline constexpr auto is_rounding_v<std::plus<T>> = true;
+
+    template <typename T>
+    inline constexpr auto is_rounding_v<std::multiplies<T>> = true;
+
+    // floating point sums and products round differently once regrouped, parallel folds only split them
+    // into partial folds given reassociate, or when the operator was declared with associative(f)
+    template <typename F, typename R, typename T>
+    concept exact_tree_fold = is_associative_v<F> && !(is_rounding_v<std::remove_cvref_t<F>> &&
+                              (std::is_floating_point_v<std::ranges::range_value_t<R>> || std::is_floating_point_v<T>));
+
+    // the type a typed functor converts its operands to, void for transparent and generic ones
+    template <typename F>
+    struct operand_type : std::type_identity<void>
+    {
+    };
+
+    template <typename F>
+    using operand_type_t = typename operand_type<std::remove_cvref_t<F>>::type;
+
+    template <typename T>
+    struct operand_type<std::plus<T>> : std::type_identity<T>
+    {
+    };
+
+    template <typename T>
+    struct operand_type<std::multiplies<T>> : std::type_identity<T>
+    {
+    };
+
+    // a typed functor narrows every partial result, only regroup it when that conversion is a no-op
+    template <typename F, typename E, typename T>
+    concept keeps_operands = std::is_void_v<operand_type_t<F>> || std::is_same_v<operand_type_t<F>, E> && std::is_same_v<operand_type_t<F>, T>;
+
+    template <typename F, typename R, typename T>
+    concept reassociable_fold = is_reassociable_v<F> && std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+                                std::is_arithmetic_v<std::ranges::range_value_t<R>> && std::is_arithmetic_v<T> &&
+                                !std::is_same_v<std::ranges::range_value_t<R>, bool> && !std::is_same_v<T, bool> &&
+                                keeps_operands<F, std::ranges::range_value_t<R>, T>;
+
+    // integral sums and products are computed modulo 2^n whatever the grouping, min and max never round,
+    // so these folds give exactly the sequential result and need no opt-in
+    template <typename F, typename R, typename T>
+    concept exact_fold = reassociable_fold<F, R, T> && std::is_integral_v<std::ranges::range_value_t<R>> && std::is_integral_v<T> &&
+                         (!std::is_same_v<std::remove_cvref_t<F>, min_op> && !std::is_same_v<std::remove_cvref_t<F>, max_op> ||
+                          std::is_same_v<std::ranges::range_value_t<R>, T>);
+
+    template <typename F>
+    class associative_function
+    {
+        public:
+            explicit associative_function(F f) : f(std::move(f))
+            {
+            }
+
+            template <typename... Args>
+            decltype(auto) operator()(Args&&... args) const
+            {
+                return std::invoke(f, std::forward<Args>(args)...);
+            }
+
+        private:
+            F f;
+    };
+
+    template <typename F>
+    struct is_associative<associative_function<F>> : std::true_type
+    {
+    };
+
+    // declares a user defined operator associative, e.g. foldl(pool, associative(max), r, t)
+    template <typename F>
+    auto associative(F&& f)
+    {
+        return associative_function<std::decay_t<F>>(std::forward<F>(f));
+    }
+
     template <typename F, typename R>
     R mapf(F&& f, R&& r)
     {
@@ -22,16 +225,374 @@ namespace monster
         return r;
     }
 
+    // transforms in place and hands the same range back, never copies it
+    template <typename F, typename R>
+    R& mapf_in_place(F&& f, R& r)
+    {
+        std::transform(std::begin(r), std::end(r), std::begin(r), std::forward<F>(f));
+        return r;
+    }
+
+    // writes f(e) for every element e to out, returns the end of the output
+    template <typename F, typename R, typename O>
+    O mapf_into(F&& f, R&& r, O out)
+    {
+        return std::transform(std::begin(r), std::end(r), out, std::forward<F>(f));
+    }
+
+    // returns a new container of U sized once up front, r itself is left untouched
+    template <typename U = void, template <typename...> typename C = std::vector, typename F, typename R>
+    auto mapf_to(F&& f, const R& r)
+    {
+        using value_type = std::conditional_t<std::is_void_v<U>, std::decay_t<std::invoke_result_t<F&, decltype(*std::begin(r))>>, U>;
+
+        C<value_type> c;
+        if constexpr(requires { c.reserve(0); })
+            c.reserve(std::size(r));
+
+        std::transform(std::begin(r), std::end(r), std::back_inserter(c), std::forward<F>(f));
+        return c;
+    }
+
+    template <typename F>
+    inline constexpr auto is_multiplies_v = false;
+
+    template <typename T>
+    inline constexpr auto is_multiplies_v<std::multiplies<T>> = true;
+
+    template <size_t L = 8, typename F, typename E, typename T>
+    constexpr T fold_lanes(F&& f, const E* p, size_t n, T t)
+    {
+        if (n < L)
+        {
+            for (size_t i = 0; i != n; ++i)
+                 t = f(std::move(t), p[i]);
+            return t;
+        }
+
+        T acc[L];
+        for (size_t j = 0; j != L; ++j)
+             acc[j] = p[j];
+
+        size_t i = L;
+        for (; i + L <= n; i += L)
+             for (size_t j = 0; j != L; ++j)
+                  acc[j] = f(acc[j], p[i + j]);
+
+        for (size_t step = 1; step != L; step *= 2)
+             for (size_t j = 0; j != L; j += 2 * step)
+                  acc[j] = f(acc[j], acc[j + step]);
+
+        t = f(std::move(t), acc[0]);
+        for (; i != n; ++i)
+             t = f(std::move(t), p[i]);
+
+        return t;
+    }
+
+    template <typename F, typename R, typename T>
+    constexpr T fold_reassociated(F& f, R& r, T t)
+    {
+        using E = std::ranges::range_value_t<R>;
+        using O = std::remove_cvref_t<F>;
+
+        auto p = std::ranges::data(r);
+        auto n = std::ranges::size(r);
+
+        if constexpr(std::is_integral_v<T> && !std::is_same_v<O, min_op> && !std::is_same_v<O, max_op>)
+        {
+            // wraps instead of overflowing, converted back to T modulo 2^n
+            using U = std::make_unsigned_t<std::common_type_t<T, E, int>>;
+
+            if constexpr(is_multiplies_v<O>)
+                return T(fold_lanes([](U x, U y){ return U(x * y); }, p, n, U(t)));
+            else
+                return T(fold_lanes([](U x, U y){ return U(x + y); }, p, n, U(t)));
+        }
+        else
+            return fold_lanes(f, p, n, std::move(t));
+    }
+
     template <typename F, typename R, typename T>
     constexpr T foldl(F&& f, R&& r, T t)
     {
-        return std::accumulate(std::begin(r), std::end(r), std::move(t), std::forward<F>(f));
+        if constexpr(exact_fold<F, R, T>)
+            return fold_reassociated(f, r, std::move(t));
+        else if constexpr(std::ranges::common_range<R>)
+            return std::accumulate(std::begin(r), std::end(r), std::move(t), std::forward<F>(f));
+        else
+        {
+            for (auto&& e : r)
+                 t = f(std::move(t), std::forward<decltype(e)>(e));
+            return t;
+        }
     }
 
     template <typename F, typename R, typename T>
     constexpr T foldr(F&& f, R&& r, T t)
     {
-        return std::accumulate(std::rbegin(r), std::rend(r), std::move(t), std::forward<F>(f));
+        if constexpr(exact_fold<F, R, T>)
+            return fold_reassociated(f, r, std::move(t));
+        else
+            return std::accumulate(std::rbegin(r), std::rend(r), std::move(t), std::forward<F>(f));
+    }
+
+    template <typename F, typename R, typename T>
+    constexpr T foldl(F&& f, R&& r, T t, reassociate_t)
+    {
+        if constexpr(reassociable_fold<F, R, T>)
+            return fold_reassociated(f, r, std::move(t));
+        else
+            return foldl(std::forward<F>(f), std::forward<R>(r), std::move(t));
+    }
+
+    template <typename F, typename R, typename T>
+    constexpr T foldr(F&& f, R&& r, T t, reassociate_t)
+    {
+        if constexpr(reassociable_fold<F, R, T>)
+            return fold_reassociated(f, r, std::move(t));
+        else
+            return foldr(std::forward<F>(f), std::forward<R>(r), std::move(t));
+    }
+
+    // folds an input range that can be traversed only once, e.g. std::istream_iterator over a socket
+    template <typename F, std::input_iterator I, std::sentinel_for<I> S, typename T>
+    T foldl_stream(F&& f, I first, S last, T t)
+    {
+        for (; first != last; ++first)
+             t = f(std::move(t), *first);
+        return t;
+    }
+
+    // produce() returns the next chunk as a range, an empty one ends the stream,
+    // only one chunk has to be in memory at a time
+    template <typename F, typename P, typename T>
+    T foldl_chunks(F&& f, P&& produce, T t)
+    {
+        while (true)
+        {
+            auto&& chunk = produce();
+            if (std::empty(chunk))
+                return t;
+            for (auto&& e : chunk)
+                 t = f(std::move(t), e);
+        }
+    }
+
+    // produce() returns the chunks from the last to the first one, each of them in its original order
+    template <typename F, typename P, typename T>
+    T foldr_chunks(F&& f, P&& produce, T t)
+    {
+        while (true)
+        {
+            auto&& chunk = produce();
+            if (std::empty(chunk))
+                return t;
+            for (auto it = std::rbegin(chunk); it != std::rend(chunk); ++it)
+                 t = f(std::move(t), *it);
+        }
+    }
+
+    // reads consecutive binary records of T from a stream, chunk by chunk
+    template <typename T>
+    class chunk_reader
+    {
+        public:
+            static_assert(std::is_trivially_copyable_v<T>, "chunk_reader requires trivially copyable records");
+
+            explicit chunk_reader(std::istream& is, size_t chunk = 1 << 16) : is(is), buffer(chunk)
+            {
+            }
+
+            std::span<const T> operator()()
+            {
+                is.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(T));
+                if (is.bad() || is.gcount() % sizeof(T))
+                    throw std::runtime_error("chunk_reader: read failed");
+                return std::span<const T>(buffer.data(), is.gcount() / sizeof(T));
+            }
+
+        private:
+            std::istream& is;
+            std::vector<T> buffer;
+    };
+
+    // reads the binary records of T of a seekable stream backwards, chunk by chunk, for foldr_chunks
+    template <typename T>
+    class reverse_chunk_reader
+    {
+        public:
+            static_assert(std::is_trivially_copyable_v<T>, "reverse_chunk_reader requires trivially copyable records");
+
+            explicit reverse_chunk_reader(std::istream& is, size_t chunk = 1 << 16) : is(is), buffer(chunk)
+            {
+                is.seekg(0, std::ios::end);
+                auto size = static_cast<size_t>(is.tellg());
+
+                if (!is || size % sizeof(T))
+                    throw std::runtime_error("reverse_chunk_reader: not a stream of records");
+                left = size / sizeof(T);
+            }
+
+            std::span<const T> operator()()
+            {
+                size_t n = std::min(left, buffer.size());
+                left -= n;
+
+                if (n && !(is.seekg(left * sizeof(T)) && is.read(reinterpret_cast<char*>(buffer.data()), n * sizeof(T))))
+                    throw std::runtime_error("reverse_chunk_reader: read failed");
+                return std::span<const T>(buffer.data(), n);
+            }
+
+        private:
+            std::istream& is;
+            std::vector<T> buffer;
+            size_t left;
+    };
+
+    template <template <typename...> typename C = std::vector, typename R>
+    auto collect(R&& r)
+    {
+        C<std::ranges::range_value_t<R>> c;
+
+        if constexpr(std::ranges::sized_range<R> && requires { c.reserve(0); })
+            c.reserve(std::ranges::size(r));
+
+        for (auto&& e : r)
+             c.insert(c.end(), std::forward<decltype(e)>(e));
+
+        return c;
+    }
+
+    // lazy adaptors compose with | and do nothing until the pipeline is consumed by foldl, collect
+    // or a loop, then every element flows through all of the stages in a single pass
+    namespace lazy
+    {
+        template <std::ranges::input_range... V>
+        requires (std::ranges::view<V> && ...)
+        class zip_view : public std::ranges::view_interface<zip_view<V...>>
+        {
+            public:
+                class iterator
+                {
+                    public:
+                        using value_type = std::tuple<std::ranges::range_value_t<V>...>;
+                        using reference = std::tuple<std::ranges::range_reference_t<V>...>;
+                        using difference_type = std::ptrdiff_t;
+                        using iterator_concept = std::input_iterator_tag;
+
+                        iterator() = default;
+
+                        iterator(std::tuple<std::ranges::iterator_t<V>...> first, std::tuple<std::ranges::sentinel_t<V>...> last) :
+                        first(std::move(first)), last(std::move(last))
+                        {
+                        }
+
+                        reference operator*() const
+                        {
+                            return std::apply([](auto&... i){ return reference(*i...); }, first);
+                        }
+
+                        iterator& operator++()
+                        {
+                            std::apply([](auto&... i){ (++i, ...); }, first);
+                            return *this;
+                        }
+
+                        void operator++(int)
+                        {
+                            ++*this;
+                        }
+
+                        // stops at the end of the shortest range
+                        friend bool operator==(const iterator& i, std::default_sentinel_t)
+                        {
+                            return [&]<size_t... I>(std::index_sequence<I...>)
+                            {
+                                return ((std::get<I>(i.first) == std::get<I>(i.last)) || ...);
+                            }(std::index_sequence_for<V...>());
+                        }
+
+                    private:
+                        std::tuple<std::ranges::iterator_t<V>...> first;
+                        std::tuple<std::ranges::sentinel_t<V>...> last;
+                };
+
+                zip_view() = default;
+
+                explicit zip_view(V... v) : views(std::move(v)...)
+                {
+                }
+
+                iterator begin()
+                {
+                    return iterator(std::apply([](auto&... v){ return std::tuple(std::ranges::begin(v)...); }, views),
+                                    std::apply([](auto&... v){ return std::tuple(std::ranges::end(v)...); }, views));
+                }
+
+                std::default_sentinel_t end() const
+                {
+                    return std::default_sentinel;
+                }
+
+            private:
+                std::tuple<V...> views;
+        };
+
+        template <typename F>
+        auto map(F&& f)
+        {
+            return std::views::transform(std::forward<F>(f));
+        }
+
+        template <typename P>
+        auto filter(P&& p)
+        {
+            return std::views::filter(std::forward<P>(p));
+        }
+
+        inline auto take(size_t n)
+        {
+            return std::views::take(n);
+        }
+
+        // yields tuples of references to the elements at the same position of every range
+        template <std::ranges::viewable_range... R>
+        auto zip(R&&... r)
+        {
+            return zip_view<std::views::all_t<R>...>(std::views::all(std::forward<R>(r))...);
+        }
+    }
+
+    // folds [first, last) as blocks partial folds, run(blocks, g) calls g(b) for every block b,
+    // the partials are then combined pairwise, neighbours first, which keeps the order of the operands
+    template <typename F, typename I, typename T, typename Run>
+    T tree_fold(F& f, I first, I last, T t, size_t blocks, Run&& run)
+    {
+        size_t n = std::distance(first, last);
+        blocks = std::min(n, std::max(blocks, size_t(1)));
+
+        if (blocks == 0)
+            return t;
+
+        std::vector<std::optional<T>> partials(blocks);
+
+        run(blocks, [&](size_t b)
+        {
+            auto begin = first + n * b / blocks;
+            auto end = first + n * (b + 1) / blocks;
+
+            T acc = *begin;
+            while (++begin != end)
+                   acc = f(std::move(acc), *begin);
+            partials[b] = std::move(acc);
+        });
+
+        for (size_t step = 1; step < blocks; step *= 2)
+             for (size_t i = 0; i + step < blocks; i += 2 * step)
+                  partials[i] = f(std::move(*partials[i]), std::move(*partials[i + step]));
+
+        return f(std::move(t), std::move(*partials[0]));
     }
 }
 
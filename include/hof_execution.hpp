@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+#ifndef HOF_EXECUTION_HPP
+#define HOF_EXECUTION_HPP
+
+#include <thread>
+#include <execution>
+#include "hof.hpp"
+#include "thread_pool.hpp"
+
+// Parallel overloads of mapf, foldl and foldr on a thread_pool or an execution policy, kept apart from hof.hpp
+// so that sequential users need neither threads nor TBB, which libstdc++ builds the parallel policies on.
+
+namespace monster
+{
+    template <typename F, typename R>
+    requires std::ranges::random_access_range<R>
+    R mapf(thread_pool& pool, F&& f, R&& r)
+    {
+        auto first = std::begin(r);
+        pool.parallel_for(0, std::size(r), [&](size_t i){ first[i] = f(first[i]); });
+        return r;
+    }
+
+    template <typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldl(thread_pool& pool, F&& f, R&& r, T t, reassociate_t)
+    {
+        if constexpr(is_associative_v<F>)
+            return tree_fold(f, std::begin(r), std::end(r), std::move(t), pool.size(),
+                             [&pool](size_t n, auto&& g){ pool.parallel_for(0, n, g); });
+        else
+            return foldl(std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+    }
+
+    template <typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldr(thread_pool& pool, F&& f, R&& r, T t, reassociate_t)
+    {
+        if constexpr(is_associative_v<F>)
+            return tree_fold(f, std::rbegin(r), std::rend(r), std::move(t), pool.size(),
+                             [&pool](size_t n, auto&& g){ pool.parallel_for(0, n, g); });
+        else
+            return foldr(std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+    }
+
+    template <typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldl(thread_pool& pool, F&& f, R&& r, T t)
+    {
+        if constexpr(exact_tree_fold<F, R, T>)
+            return foldl(pool, std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+        else
+            return foldl(std::forward<F>(f), std::forward<R>(r), std::move(t));
+    }
+
+    template <typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldr(thread_pool& pool, F&& f, R&& r, T t)
+    {
+        if constexpr(exact_tree_fold<F, R, T>)
+            return foldr(pool, std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+        else
+            return foldr(std::forward<F>(f), std::forward<R>(r), std::move(t));
+    }
+
+    template <typename P>
+    concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<P>>;
+
+    template <execution_policy P, typename F, typename R>
+    R mapf(P&& policy, F&& f, R&& r)
+    {
+        std::transform(std::forward<P>(policy), std::begin(r), std::end(r), std::begin(r), std::forward<F>(f));
+        return r;
+    }
+
+    template <execution_policy P, typename F, typename I, typename T>
+    T policy_fold(P&& policy, F& f, I first, I last, T t)
+    {
+        return tree_fold(f, first, last, std::move(t), std::thread::hardware_concurrency(), [&policy](size_t n, auto&& g)
+        {
+            std::vector<size_t> blocks(n);
+            std::iota(blocks.begin(), blocks.end(), 0);
+            std::for_each(std::forward<P>(policy), blocks.begin(), blocks.end(), g);
+        });
+    }
+
+    template <execution_policy P, typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldl(P&& policy, F&& f, R&& r, T t, reassociate_t)
+    {
+        if constexpr(is_associative_v<F>)
+            return policy_fold(std::forward<P>(policy), f, std::begin(r), std::end(r), std::move(t));
+        else
+            return foldl(std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+    }
+
+    template <execution_policy P, typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldr(P&& policy, F&& f, R&& r, T t, reassociate_t)
+    {
+        if constexpr(is_associative_v<F>)
+            return policy_fold(std::forward<P>(policy), f, std::rbegin(r), std::rend(r), std::move(t));
+        else
+            return foldr(std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+    }
+
+    template <execution_policy P, typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldl(P&& policy, F&& f, R&& r, T t)
+    {
+        if constexpr(exact_tree_fold<F, R, T>)
+            return foldl(std::forward<P>(policy), std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+        else
+            return foldl(std::forward<F>(f), std::forward<R>(r), std::move(t));
+    }
+
+    template <execution_policy P, typename F, typename R, typename T>
+    requires std::ranges::random_access_range<R>
+    T foldr(P&& policy, F&& f, R&& r, T t)
+    {
+        if constexpr(exact_tree_fold<F, R, T>)
+            return foldr(std::forward<P>(policy), std::forward<F>(f), std::forward<R>(r), std::move(t), reassociate);
+        else
+            return foldr(std::forward<F>(f), std::forward<R>(r), std::move(t));
+    }
+}
+
+#endif
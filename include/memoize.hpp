@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+#ifndef MEMOIZE_HPP
+#define MEMOIZE_HPP
+
+#include <list>
+#include <mutex>
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+namespace monster
+{
+    struct tuple_hash
+    {
+        template <typename... T>
+        size_t operator()(const std::tuple<T...>& t) const
+        {
+            return std::apply([](const auto&... e)
+            {
+                size_t seed = sizeof...(T);
+                ((seed ^= std::hash<std::decay_t<decltype(e)>>()(e) + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2)), ...);
+                return seed;
+            }, t);
+        }
+    };
+
+    template <typename F>
+    struct signature : signature<decltype(&F::operator())>
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct signature<R(Args...)>
+    {
+        using type = R(Args...);
+    };
+
+    template <typename R, typename... Args>
+    struct signature<R(*)(Args...)> : signature<R(Args...)>
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct signature<R(*)(Args...) noexcept> : signature<R(Args...)>
+    {
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct signature<R(C::*)(Args...)> : signature<R(Args...)>
+    {
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct signature<R(C::*)(Args...) const> : signature<R(Args...)>
+    {
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct signature<R(C::*)(Args...) noexcept> : signature<R(Args...)>
+    {
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct signature<R(C::*)(Args...) const noexcept> : signature<R(Args...)>
+    {
+    };
+
+    template <typename F>
+    using signature_t = typename signature<F>::type;
+
+    template <typename F, typename S>
+    class memoized;
+
+    // caches the results of a pure function in a bounded LRU keyed on the decayed arguments,
+    // the entries are spread over shards with a mutex each, so concurrent callers rarely contend,
+    // copies share the same cache, the function itself runs outside of any lock
+    template <typename F, typename R, typename... Args>
+    class memoized<F, R(Args...)>
+    {
+        public:
+            using key_type = std::tuple<std::decay_t<Args>...>;
+            using value_type = std::decay_t<R>;
+
+            memoized(F func, size_t capacity = 1024, size_t shards = 1);
+
+            value_type operator()(const std::decay_t<Args>&... args) const;
+
+            size_t size() const;
+            void clear();
+
+        private:
+            struct shard
+            {
+                std::mutex mutex;
+                std::list<std::pair<key_type, value_type>> entries;
+                std::unordered_map<key_type, typename std::list<std::pair<key_type, value_type>>::iterator, tuple_hash> index;
+            };
+
+            struct state
+            {
+                state(F func, size_t capacity, size_t shards);
+
+                F func;
+                size_t capacity;
+                std::vector<std::unique_ptr<shard>> shards;
+            };
+
+            std::shared_ptr<state> s;
+    };
+
+    template <typename F, typename R, typename... Args>
+    memoized<F, R(Args...)>::state::state(F func, size_t capacity, size_t shards) :
+    func(std::move(func)), capacity(std::max((capacity + shards - 1) / shards, size_t(1)))
+    {
+        for (size_t i = 0; i != shards; ++i)
+             this->shards.emplace_back(std::make_unique<shard>());
+    }
+
+    template <typename F, typename R, typename... Args>
+    memoized<F, R(Args...)>::memoized(F func, size_t capacity, size_t shards) :
+    s(std::make_shared<state>(std::move(func), capacity, std::max(shards, size_t(1))))
+    {
+    }
+
+    template <typename F, typename R, typename... Args>
+    auto memoized<F, R(Args...)>::operator()(const std::decay_t<Args>&... args) const -> value_type
+    {
+        key_type key(args...);
+
+        auto hash = tuple_hash()(key);
+        auto& sh = *s->shards[(hash ^ (hash >> (sizeof(size_t) * 4))) % s->shards.size()];
+
+        {
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            if (auto it = sh.index.find(key); it != sh.index.end())
+            {
+                sh.entries.splice(sh.entries.begin(), sh.entries, it->second);
+                return it->second->second;
+            }
+        }
+
+        value_type value = std::invoke(s->func, args...);
+
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        if (sh.index.find(key) == sh.index.end())
+        {
+            sh.entries.emplace_front(std::move(key), value);
+            sh.index.emplace(sh.entries.front().first, sh.entries.begin());
+
+            if (sh.entries.size() > s->capacity)
+            {
+                sh.index.erase(sh.entries.back().first);
+                sh.entries.pop_back();
+            }
+        }
+
+        return value;
+    }
+
+    template <typename F, typename R, typename... Args>
+    size_t memoized<F, R(Args...)>::size() const
+    {
+        size_t n = 0;
+        for (auto& sh : s->shards)
+        {
+             std::lock_guard<std::mutex> lock(sh->mutex);
+             n += sh->entries.size();
+        }
+        return n;
+    }
+
+    template <typename F, typename R, typename... Args>
+    void memoized<F, R(Args...)>::clear()
+    {
+        for (auto& sh : s->shards)
+        {
+             std::lock_guard<std::mutex> lock(sh->mutex);
+             sh->index.clear();
+             sh->entries.clear();
+        }
+    }
+
+    // the signature is deduced from function pointers and non-generic function objects
+    template <typename F>
+    auto memoize(F func, size_t capacity = 1024, size_t shards = 1)
+    {
+        return memoized<F, signature_t<F>>(std::move(func), capacity, shards);
+    }
+
+    // an explicit signature, e.g. memoize<double(double, int)>(f), covers generic lambdas
+    template <typename S, typename F>
+    auto memoize(F func, size_t capacity = 1024, size_t shards = 1)
+    {
+        return memoized<F, S>(std::move(func), capacity, shards);
+    }
+}
+
+#endif
@@ -24,6 +24,8 @@
 
 #define MONSTER_VERSION_STRING "Monster/" STRINGIZE(MONSTER_VERSION)
 
+#include <array>
+#include <iosfwd>
 #include <tuple>
 #include <utility>
 #include <functional>
@@ -158,13 +160,41 @@ namespace monster
     template <auto N, typename T>
     using index_upper = wrapper_t<1, index_type<N, T>>;
 
+    // every argument becomes a distinct base, so looking one up by its index is a single overload resolution
     template <typename T, typename... Args>
-    struct last : last<Args...>
+    struct index_map;
+
+    template <size_t... indices, typename... Args>
+    struct index_map<std::index_sequence<indices...>, Args...> : index_type<indices, Args>...
     {
     };
 
-    template <typename T>
-    struct last<T> : std::type_identity<T>
+    template <size_t N, typename T>
+    index_type<N, T> index_of(const index_type<N, T>&);
+
+#ifdef __has_builtin
+#if __has_builtin(__type_pack_element)
+#define MONSTER_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+#ifdef MONSTER_TYPE_PACK_ELEMENT
+    template <size_t N, typename... Args>
+    struct nth_type : std::type_identity<__type_pack_element<N, Args...>>
+    {
+    };
+#else
+    template <size_t N, typename... Args>
+    struct nth_type : decltype(index_of<N>(std::declval<index_map<std::index_sequence_for<Args...>, Args...>>()))
+    {
+    };
+#endif
+
+    template <size_t N, typename... Args>
+    using nth_type_t = typeof_t<nth_type<N, Args...>>;
+
+    template <typename T, typename... Args>
+    struct last : nth_type<sizeof...(Args), T, Args...>
     {
     };
 
@@ -224,6 +254,35 @@ namespace monster
     template <auto value, auto... values>
     inline constexpr auto comprise_v<value, values...> = std::disjunction_v<bool_<value == values>...>;
 
+    // the arguments become distinct bases, so testing whether a type is one of them is a single base lookup
+    template <typename... Args>
+    struct type_set : std::type_identity<Args>...
+    {
+    };
+
+    template <typename T, typename U>
+    struct in_type_set;
+
+    template <typename T, typename... Args>
+    struct in_type_set<T, type_set<Args...>> : std::is_base_of<std::type_identity<T>, type_set<Args...>>
+    {
+    };
+
+    template <typename T, typename U>
+    inline constexpr auto in_type_set_v = typev<in_type_set<T, U>>;
+
+    // inserts the arguments one by one and stops at the first one already in the set
+    template <typename T, typename... Args>
+    struct distinct_type : std::true_type
+    {
+    };
+
+    template <typename... seen, typename T, typename... Args>
+    struct distinct_type<type_set<seen...>, T, Args...> : std::conditional_t<in_type_set_v<T, type_set<seen...>>,
+    std::false_type, distinct_type<type_set<seen..., T>, Args...>>
+    {
+    };
+
     template <typename B, typename ...>
     struct exists_type : B
     {
@@ -241,22 +300,16 @@ namespace monster
     inline constexpr auto exists_type_v = typev<exists_type_t<B, Args...>>;
 
     template <typename... Args>
-    using is_unique_type = exists_type<std::true_type, Args...>;
-
-    template <typename ...>
-    inline constexpr auto is_unique_type_v = std::true_type{};
-
-    template <typename T, typename... Args>
-    inline constexpr auto is_unique_type_v<T, Args...> = negav<contains<T, Args...>> && is_unique_type_v<Args...>;
+    using is_unique_type = distinct_type<type_set<>, Args...>;
 
     template <typename... Args>
-    using has_duplicates_type = exists_type<std::false_type, Args...>;
+    inline constexpr auto is_unique_type_v = typev<is_unique_type<Args...>>;
 
-    template <typename ...>
-    inline constexpr auto has_duplicates_type_v = std::false_type{};
+    template <typename... Args>
+    using has_duplicates_type = std::negation<is_unique_type<Args...>>;
 
-    template <typename T, typename... Args>
-    inline constexpr auto has_duplicates_type_v<T, Args...> = typev<contains<T, Args...>> || has_duplicates_type_v<Args...>;
+    template <typename... Args>
+    inline constexpr auto has_duplicates_type_v = typev<has_duplicates_type<Args...>>;
 
     template <typename B, auto ...>
     struct exists_value : B
@@ -274,23 +327,18 @@ namespace monster
     template <typename B, auto... values>
     inline constexpr auto exists_value_v = typev<exists_value_t<B, values...>>;
 
+    // values are compared in their common type, as comprise does
     template <auto... values>
-    using is_unique_value = exists_value<std::true_type, values...>;
-
-    template <auto ...>
-    inline constexpr auto is_unique_value_v = std::true_type{};
-
-    template <auto value, auto... values>
-    inline constexpr auto is_unique_value_v<value, values...> = negav<comprise<value, values...>> && is_unique_value_v<values...>;
+    using is_unique_value = is_unique_type<int_<values, std::common_type_t<decltype(values)...>>...>;
 
     template <auto... values>
-    using has_duplicates_value = exists_value<std::false_type, values...>;
+    inline constexpr auto is_unique_value_v = typev<is_unique_value<values...>>;
 
-    template <auto ...>
-    inline constexpr auto has_duplicates_value_v = std::false_type{};
+    template <auto... values>
+    using has_duplicates_value = std::negation<is_unique_value<values...>>;
 
-    template <auto value, auto... values>
-    inline constexpr auto has_duplicates_value_v<value, values...> = typev<comprise<value, values...>> || has_duplicates_value_v<values...>;
+    template <auto... values>
+    inline constexpr auto has_duplicates_value_v = typev<has_duplicates_value<values...>>;
 
     template <bool B, typename T>
     struct exists;
@@ -566,6 +614,10 @@ namespace monster
     template <typename T>
     inline constexpr auto sizeof_t_v = typev<sizeof_t<T>>;
 
+    // counts the arguments directly, probing sizeof_t would instantiate the whole std::tuple
+    template <typename... Args>
+    inline constexpr auto sizeof_t_v<std::tuple<Args...>> = sizeof...(Args);
+
     template <typename T>
     struct argument_size : argument_size<decltype(&T::operator())>
     {
@@ -655,29 +707,109 @@ namespace monster
         }
     };
 
+    // the values laid out in a constant array, indexed without any recursion
+    template <typename T, auto... values>
+    inline constexpr T value_array[] = {values...};
+
     template <size_t N, typename T>
     struct get;
 
-    template <template <typename, auto ...> typename T, typename U, auto value, auto... values>
-    struct get<0, T<U, value, values...>> : int_<value, U>
+    template <size_t N, template <typename, auto ...> typename T, typename U, auto value, auto... values>
+    struct get<N, T<U, value, values...>> : int_<value_array<U, value, values...>[N], U>
     {
     };
 
-    template <size_t N, template <typename, auto ...> typename T, typename U, auto value, auto... values>
-    struct get<N, T<U, value, values...>> : int_<typev<get<N - 1, T<U, values...>>>, U>
+    template <size_t N, auto value, auto... values>
+    struct get<N, homogeneous<value, values...>> : int_<value_array<decltype(value), value, values...>[N]>
     {
     };
 
-    template <auto value, auto... values>
-    struct get<0, homogeneous<value, values...>> : int_<value>
+    // an opt-in view of a list that builds its lookup structure once, element, get, sizeof_t and base_type
+    // see through it and index it in constant depth instead of re-deriving the list on every access
+    template <typename T>
+    struct indexed;
+
+    template <typename T>
+    struct indexed<indexed<T>> : indexed<T>
     {
     };
 
-    template <size_t N, auto value, auto... values>
-    struct get<N, homogeneous<value, values...>> : int_<typev<get<N - 1, homogeneous<values...>>>>
+    template <typename... Args>
+    struct indexed<std::tuple<Args...>> : index_map<std::index_sequence_for<Args...>, Args...>
+    {
+        using type = std::tuple<Args...>;
+
+        auto static constexpr size()
+        {
+            return sizeof...(Args);
+        }
+    };
+
+    template <typename U, U... values>
+    struct indexed<std::integer_sequence<U, values...>>
+    {
+        using type = std::integer_sequence<U, values...>;
+        using value_type = U;
+
+        static constexpr std::array<U, sizeof...(values)> array = {values...};
+
+        auto static constexpr size()
+        {
+            return sizeof...(values);
+        }
+    };
+
+    // the lookups name the view only, member templates of the view would carry all of its arguments
+    template <size_t N, typename T>
+    requires is_tuple_v<T>
+    struct get<N, indexed<T>> : decltype(monster::index_of<N>(std::declval<indexed<T>>()))
+    {
+    };
+
+    template <size_t N, typename T>
+    requires (!is_tuple_v<T>)
+    struct get<N, indexed<T>> : int_<indexed<T>::array[N], typename indexed<T>::value_type>
     {
     };
 
+    template <size_t N, typename T>
+    struct get<N, indexed<indexed<T>>> : get<N, indexed<T>>
+    {
+    };
+
+    template <typename T>
+    struct unindexed : std::type_identity<T>
+    {
+    };
+
+    template <typename T>
+    struct unindexed<indexed<T>> : unindexed<T>
+    {
+    };
+
+    template <typename T>
+    using unindexed_t = typeof_t<unindexed<T>>;
+
+    template <typename T>
+    inline constexpr auto is_indexed_v = !std::is_same_v<T, unindexed_t<T>>;
+
+    template <typename T>
+    struct base_type<indexed<T>> : base_type<unindexed_t<T>>
+    {
+    };
+
+    template <typename T>
+    struct sizeof_t<indexed<T>> : sizeof_t<unindexed_t<T>>
+    {
+    };
+
+    template <typename T>
+    inline constexpr auto sizeof_t_v<indexed<T>> = sizeof_t_v<unindexed_t<T>>;
+
+    // the view of a tuple or an integer sequence, any other list is left as it is
+    template <typename T>
+    using indexed_t = std::conditional_t<is_tuple_v<unindexed_t<T>> || is_sequence_v<unindexed_t<T>>, indexed<unindexed_t<T>>, T>;
+
     template <size_t N, typename T>
     using get_t = typeof_t<get<N, T>>;
 
@@ -716,8 +848,16 @@ namespace monster
     template <typename T>
     inline constexpr auto sum_v = typev<sum<T>>;
 
+    template <size_t N, typename T>
+    struct tuple_nth;
+
+    template <size_t N, typename... Args>
+    struct tuple_nth<N, std::tuple<Args...>> : nth_type<N, Args...>
+    {
+    };
+
     template <auto N, typename T>
-    using element = std::conditional_t<is_tuple_v<T>, std::tuple_element<N, T>, get<N, T>>;
+    using element = std::conditional_t<is_tuple_v<T>, tuple_nth<N, T>, get<N, T>>;
 
     template <auto N, typename T>
     using element_t = typeof_t<element<N, T>>;
@@ -785,6 +925,172 @@ namespace monster
     template <typename T>
     inline constexpr auto negate_v = typev<negate_t<T>>;
 
+    // the values of an integer sequence as a std::array
+    template <typename T>
+    struct array_of;
+
+    template <typename U, U... values>
+    struct array_of<std::integer_sequence<U, values...>>
+    {
+        static constexpr std::array<U, sizeof...(values)> value = {values...};
+    };
+
+    template <typename T>
+    inline constexpr auto array_of_v = typev<array_of<T>>;
+
+    // evaluates F()(a...) in a constant expression, a is the std::array of the values of each sequence
+    template <typename F, typename... T>
+    struct array_call
+    {
+        static constexpr auto value = F()(array_of_v<T>...);
+    };
+
+    // a std::array becomes a sequence, a std::pair of a std::array and a size becomes a sequence of
+    // its leading size values, any other result becomes an int_
+    template <typename T, typename R = std::remove_cv_t<decltype(typev<T>)>>
+    struct from_array : int_<typev<T>>
+    {
+    };
+
+    template <typename T, typename U, size_t N>
+    struct from_array<T, std::array<U, N>>
+    {
+        template <typename indices>
+        struct impl;
+
+        template <size_t... n>
+        struct impl<std::index_sequence<n...>> : std::type_identity<std::integer_sequence<U, typev<T>[n]...>>
+        {
+        };
+
+        using type = typeof_t<impl<std::make_index_sequence<N>>>;
+    };
+
+    template <typename T, typename U, size_t N>
+    struct from_array<T, std::pair<std::array<U, N>, size_t>>
+    {
+        template <typename indices>
+        struct impl;
+
+        template <size_t... n>
+        struct impl<std::index_sequence<n...>> : std::type_identity<std::integer_sequence<U, typev<T>.first[n]...>>
+        {
+        };
+
+        using type = typeof_t<impl<std::make_index_sequence<typev<T>.second>>>;
+    };
+
+    template <typename F, typename... T>
+    using array_apply = from_array<array_call<F, T...>>;
+
+    template <typename F, typename... T>
+    using array_apply_t = typeof_t<array_apply<F, T...>>;
+
+    template <typename F, typename... T>
+    inline constexpr auto array_apply_v = typev<array_call<F, T...>>;
+
+    // the function object computing the same value as the arithmetic metafunction F
+    template <template <typename, typename> typename F>
+    struct value_op : std::type_identity<void>
+    {
+    };
+
+    template <>
+    struct value_op<plus_t> : std::type_identity<std::plus<>>
+    {
+    };
+
+    template <>
+    struct value_op<minus_t> : std::type_identity<std::minus<>>
+    {
+    };
+
+    template <>
+    struct value_op<multiplies_t> : std::type_identity<std::multiplies<>>
+    {
+    };
+
+    template <>
+    struct value_op<divides_t> : std::type_identity<std::divides<>>
+    {
+    };
+
+    template <>
+    struct value_op<modulus_t> : std::type_identity<std::modulus<>>
+    {
+    };
+
+    template <template <typename, typename> typename F>
+    using value_op_t = typeof_t<value_op<F>>;
+
+    template <template <typename, typename> typename comparator>
+    struct key_order : int_<0>
+    {
+    };
+
+    template <>
+    struct key_order<less_t> : int_<1>
+    {
+    };
+
+    template <>
+    struct key_order<less_equal_t> : int_<1>
+    {
+    };
+
+    template <>
+    struct key_order<greater_t> : int_<-1>
+    {
+    };
+
+    template <>
+    struct key_order<greater_equal_t> : int_<-1>
+    {
+    };
+
+    template <template <typename, typename> typename comparator>
+    inline constexpr auto key_order_v = typev<key_order<comparator>>;
+
+    // bottom-up merge sort of the positions of keys, equal keys keep their input order
+    template <int order, typename T, size_t N>
+    constexpr auto sort_permutation(const std::array<T, N>& keys)
+    {
+        std::array<size_t, N> curr{};
+        std::array<size_t, N> next{};
+
+        for (size_t i = 0; i != N; ++i)
+            curr[i] = i;
+
+        for (size_t width = 1; width < N; width *= 2)
+        {
+            for (size_t lower = 0; lower < N; lower += 2 * width)
+            {
+                size_t mid = lower + width < N ? lower + width : N;
+                size_t upper = mid + width < N ? mid + width : N;
+
+                size_t i = lower;
+                size_t j = mid;
+                size_t k = lower;
+
+                while (i != mid && j != upper)
+                {
+                    bool right = order > 0 ? keys[curr[j]] < keys[curr[i]] : keys[curr[i]] < keys[curr[j]];
+                    next[k++] = right ? curr[j++] : curr[i++];
+                }
+
+                while (i != mid)
+                    next[k++] = curr[i++];
+
+                while (j != upper)
+                    next[k++] = curr[j++];
+            }
+
+            curr = next;
+        }
+
+        return curr;
+    }
+
     template <typename T>
     struct pred : int_<typev<T> - 1, value_t<T>>
     {
@@ -1220,22 +1526,6 @@ namespace monster
     template <template <typename ...> typename F, typename T, auto B = 0, auto E = sizeof_t_v<T>>
     inline constexpr auto any_of_v = typev<any_of_t<F, T, B, E>>;
 
-    template <size_t N, typename... Args>
-    struct nth_type;
-    
-    template <typename T, typename... Args>
-    struct nth_type<0, T, Args...> : std::type_identity<T>
-    {
-    };
-    
-    template <size_t N, typename T, typename... Args>
-    struct nth_type<N, T, Args...> : nth_type<N - 1, Args...>
-    {
-    };
-    
-    template <size_t N, typename... Args>
-    using nth_type_t = typeof_t<nth_type<N, Args...>>;
-    
     template <typename... Args>
     using first_type = nth_type_t<0, Args...>;
 
@@ -1254,18 +1544,10 @@ namespace monster
     template <typename T, typename... Args>
     using arg_t = call_t<T, Args...>;
 
-    template <size_t N, typename T, typename... Args>
-    requires N == 0
-    decltype(auto) nth_value_v(T&& t, Args&&... args)
-    {
-        return std::forward<T>(t);
-    }
-    
-    template <size_t N, typename T, typename... Args>
-    requires N > 0
-    decltype(auto) nth_value_v(T&& t, Args&&... args)
+    template <size_t N, typename... Args>
+    decltype(auto) nth_value_v(Args&&... args)
     {
-        return std::forward<nth_type_t<N - 1, Args...>>(nth_value_v<N - 1>((std::forward<Args>(args))...));
+        return std::forward<nth_type_t<N, Args...>>(std::get<N>(std::forward_as_tuple(std::forward<Args>(args)...)));
     }
     
     template <typename... Args>
@@ -1287,10 +1569,30 @@ namespace monster
         using apply = index_tuple<indices..., N>;
     };
 
+    template <typename T, bool B>
+    struct duple;
+
+    template <size_t... indices>
+    struct duple<index_tuple<indices...>, false>
+    {
+        using type = index_tuple<indices..., (sizeof...(indices) + indices)...>;
+    };
+
+    template <size_t... indices>
+    struct duple<index_tuple<indices...>, true>
+    {
+        using type = index_tuple<indices..., (sizeof...(indices) + indices)..., sizeof...(indices) * 2>;
+    };
+
     template<size_t N>
-    struct next_index_tuple
+    struct next_index_tuple : duple<typeof_t<next_index_tuple<N / 2>>, N % 2 != 0>
+    {
+    };
+
+    template<>
+    struct next_index_tuple<1>
     {
-        using type = typeof_t<next_index_tuple<N - 1>>::template apply<N - 1>;
+        using type = index_tuple<0>;
     };
 
     template<>
@@ -1313,9 +1615,6 @@ namespace monster
     {
     };
 
-    template <typename T, bool B>
-    struct duple;
-
     template <size_t... indices>
     struct duple<index_sequence<indices...>, false>
     {
@@ -1447,6 +1746,31 @@ namespace monster
     {
     };
 
+    // longer lists are joined eight or four at a time, which cuts the depth of a many-way join accordingly
+    template <template <typename ...> typename T, typename... A1, typename... A2, typename... A3, typename... A4, typename... U>
+    struct concat<T<A1...>, T<A2...>, T<A3...>, T<A4...>, U...> : concat<T<A1..., A2..., A3..., A4...>, U...>
+    {
+    };
+
+    template <template <typename, auto ...> typename T, typename U, auto... A1, auto... A2, auto... A3, auto... A4, typename... V>
+    struct concat<T<U, A1...>, T<U, A2...>, T<U, A3...>, T<U, A4...>, V...> : concat<T<U, A1..., A2..., A3..., A4...>, V...>
+    {
+    };
+
+    template <template <typename ...> typename T, typename... A1, typename... A2, typename... A3, typename... A4,
+    typename... A5, typename... A6, typename... A7, typename... A8, typename... U>
+    struct concat<T<A1...>, T<A2...>, T<A3...>, T<A4...>, T<A5...>, T<A6...>, T<A7...>, T<A8...>, U...> :
+    concat<T<A1..., A2..., A3..., A4..., A5..., A6..., A7..., A8...>, U...>
+    {
+    };
+
+    template <template <typename, auto ...> typename T, typename U, auto... A1, auto... A2, auto... A3, auto... A4,
+    auto... A5, auto... A6, auto... A7, auto... A8, typename... V>
+    struct concat<T<U, A1...>, T<U, A2...>, T<U, A3...>, T<U, A4...>, T<U, A5...>, T<U, A6...>, T<U, A7...>, T<U, A8...>, V...> :
+    concat<T<U, A1..., A2..., A3..., A4..., A5..., A6..., A7..., A8...>, V...>
+    {
+    };
+
     template <typename... Args>
     using concat_t = typeof_t<concat<Args...>>;
 
@@ -1463,38 +1787,56 @@ namespace monster
     template <typename T>
     struct unique;
 
+    // walks the elements from the back and keeps the ones not yet in the set, that is the last occurrence of each
     template <template <typename ...> typename T, typename... Args>
     struct unique<T<Args...>>
     {
-        template <typename... args>
-        struct impl : std::type_identity<T<args...>>
+        template <typename V, typename W, typename... args>
+        struct impl : std::type_identity<W>
         {
         };
 
-        template <typename U, typename... args>
-        struct impl<U, args...>
+        template <typename... seen, typename... kept, typename V, typename... args>
+        struct impl<type_set<seen...>, T<kept...>, V, args...> : std::conditional_t<in_type_set_v<V, type_set<seen...>>,
+        impl<type_set<seen...>, T<kept...>, args...>, impl<type_set<seen..., V>, T<V, kept...>, args...>>
         {
-            using type = dedup_t<contains<U, args...>, T<U>, impl<args...>>;
         };
 
-        using type = typeof_t<impl<Args...>>;
+        template <typename indices>
+        struct backward;
+
+        template <size_t... N>
+        struct backward<std::index_sequence<N...>> : impl<type_set<>, T<>, nth_type_t<sizeof...(Args) - 1 - N, Args...>...>
+        {
+        };
+
+        using type = typeof_t<backward<std::index_sequence_for<Args...>>>;
     };
 
     template <template <typename, auto ...> typename T, typename U, auto... values>
     struct unique<T<U, values...>>
     {
-        template <auto... args>
-        struct impl : std::type_identity<T<U, args...>>
+        template <typename V, typename W, auto... args>
+        struct impl : std::type_identity<W>
         {
         };
 
-        template <auto value, auto... args>
-        struct impl<value, args...>
+        template <typename... seen, auto... kept, auto value, auto... args>
+        struct impl<type_set<seen...>, T<U, kept...>, value, args...> : std::conditional_t<in_type_set_v<int_<value, U>, type_set<seen...>>,
+        impl<type_set<seen...>, T<U, kept...>, args...>, impl<type_set<seen..., int_<value, U>>, T<U, value, kept...>, args...>>
         {
-            using type = dedup_t<comprise<value, args...>, T<U, value>, impl<args...>>;
         };
 
-        using type = typeof_t<impl<values...>>;
+        template <typename indices>
+        struct backward;
+
+        template <size_t... N>
+        struct backward<std::index_sequence<N...>> :
+        impl<type_set<>, T<U>, value_array<U, values...>[sizeof...(values) - 1 - N]...>
+        {
+        };
+
+        using type = typeof_t<backward<std::make_index_sequence<sizeof...(values)>>>;
     };
 
     template <typename T>
@@ -1609,6 +1951,27 @@ namespace monster
         using type = type_if<B == E, std::type_identity<base>, impl<B, E>>;
     };
 
+    template <template <typename, typename> typename F, typename U, U... values, auto B, auto E>
+    requires (!std::is_void_v<value_op_t<F>> && B < E)
+    struct adjacent_difference<F, std::integer_sequence<U, values...>, B, E>
+    {
+        struct call
+        {
+            template <size_t N>
+            constexpr auto operator()(const std::array<U, N>& a) const
+            {
+                std::array<U, E - B> result{a[B]};
+
+                for (size_t i = B + 1; i < E; ++i)
+                    result[i - B] = value_op_t<F>()(a[i], a[i - 1]);
+
+                return result;
+            }
+        };
+
+        using type = array_apply_t<call, std::integer_sequence<U, values...>>;
+    };
+
     template <template <typename, typename> typename F, typename T, auto B = 0, auto E = sizeof_t_v<T>>
     using adjacent_difference_t = typeof_t<adjacent_difference<F, T, B, E>>;
 
@@ -1896,23 +2259,69 @@ namespace monster
     template <typename T, bool B, typename indices = index_sequence_of_t<T>>
     using convert_t = typeof_t<convert<T, B, indices>>;
 
-    template <typename T, typename indices = index_sequence_of_t<T>>
-    using to_sequence = convert<T, true, indices>;
+    template <typename T, typename indices = index_sequence_of_t<T>>
+    using to_sequence = convert<T, true, indices>;
+
+    template <typename T, typename indices = index_sequence_of_t<T>>
+    using to_sequence_t = typeof_t<to_sequence<T, indices>>;
+
+    template <typename T, typename indices = index_sequence_of_t<T>>
+    using to_tuple = convert<T, false, indices>;
+
+    template <typename T, typename indices = index_sequence_of_t<T>>
+    using to_tuple_t = typeof_t<to_tuple<T, indices>>;
+
+    template <typename T, typename indices = index_sequence_of_t<T>>
+    using to_map = expand_of<T, indices, false>;
+
+    template <typename T, typename indices = index_sequence_of_t<T>>
+    using to_map_t = typeof_t<to_map<T, indices>>;
+
+    template <typename T, auto V>
+    struct offset_sequence;
+
+    template <typename T, T... N, auto V>
+    struct offset_sequence<std::integer_sequence<T, N...>, V> : std::type_identity<std::integer_sequence<T, (N + V)...>>
+    {
+    };
+
+    template <typename T, auto V>
+    using offset_sequence_t = typeof_t<offset_sequence<T, V>>;
+
+    // the elements of T at the given positions, built by a single pack expansion over constant depth lookups
+    template <typename T, typename indices>
+    struct pick : expand_of<T, indices>
+    {
+    };
+
+    template <typename... Args, size_t... N>
+    struct pick<std::tuple<Args...>, std::index_sequence<N...>> : std::type_identity<std::tuple<nth_type_t<N, Args...>...>>
+    {
+    };
 
-    template <typename T, typename indices = index_sequence_of_t<T>>
-    using to_sequence_t = typeof_t<to_sequence<T, indices>>;
+    template <typename U, U... values, size_t... N>
+    requires (!std::is_same_v<U, bool>)
+    struct pick<std::integer_sequence<U, values...>, std::index_sequence<N...>>
+    {
+        struct call
+        {
+            template <size_t M, size_t K>
+            constexpr auto operator()(const std::array<U, M>& a, const std::array<size_t, K>& indices) const
+            {
+                std::array<U, K> result{};
 
-    template <typename T, typename indices = index_sequence_of_t<T>>
-    using to_tuple = convert<T, false, indices>;
+                for (size_t i = 0; i != K; ++i)
+                    result[i] = a[indices[i]];
 
-    template <typename T, typename indices = index_sequence_of_t<T>>
-    using to_tuple_t = typeof_t<to_tuple<T, indices>>;
+                return result;
+            }
+        };
 
-    template <typename T, typename indices = index_sequence_of_t<T>>
-    using to_map = expand_of<T, indices, false>;
+        using type = array_apply_t<call, std::integer_sequence<U, values...>, std::index_sequence<N...>>;
+    };
 
-    template <typename T, typename indices = index_sequence_of_t<T>>
-    using to_map_t = typeof_t<to_map<T, indices>>;
+    template <typename T, typename indices>
+    using pick_t = typeof_t<pick<T, indices>>;
 
     template <auto i, auto j, auto N>
     inline constexpr auto swap_v = i == N ? j : j == N ? i : N;
@@ -1926,10 +2335,15 @@ namespace monster
     template <auto i, auto j, typename T>
     struct swap
     {
-        template <auto N, typename U>
-        using impl = element<swap_v<i, j, N>, U>;
+        template <typename indices>
+        struct impl;
 
-        using type = meta_t<T, expand<impl, T, index_sequence_of_t<T>>>;
+        template <size_t... N>
+        struct impl<std::index_sequence<N...>> : pick<T, std::index_sequence<swap_v<i, j, N>...>>
+        {
+        };
+
+        using type = meta_t<T, impl<index_sequence_of_t<T>>>;
     };
 
     template <auto i, auto j, typename T>
@@ -1944,14 +2358,8 @@ namespace monster
     template <auto n, auto lower, auto upper>
     struct within
     {
-        template <auto i>
-        struct impl
-        {
-            using cond = std::conditional_t<i + 1 >= upper, std::false_type, impl<i + 1>>;
-            using type = type_if<n == i, std::true_type, cond>;
-        };
-
-        using type = typeof_t<impl<lower>>;
+        // unary plus promotes char and bool bounds, which std::cmp_less does not accept
+        using type = bool_<std::cmp_equal(+n, +lower) || (std::cmp_less(+lower, +n) && std::cmp_less(+n, +upper))>;
     };
 
     template <auto n, auto lower, auto upper>
@@ -2042,7 +2450,38 @@ namespace monster
     using substitute_c = substitute_t<i, j, int_<N>, U>;
 
     template <auto i, typename T, typename U>
-    using exchange = substitute<i, i + 1, T, U>;
+    struct exchange : substitute<i, i + 1, T, U>
+    {
+    };
+
+    template <auto i, typename T, typename... Args>
+    struct exchange<i, T, std::tuple<Args...>>
+    {
+        template <typename indices>
+        struct impl;
+
+        template <size_t... N>
+        struct impl<std::index_sequence<N...>> : std::type_identity<std::tuple<std::conditional_t<N == i, T, Args>...>>
+        {
+        };
+
+        using type = typeof_t<impl<std::index_sequence_for<Args...>>>;
+    };
+
+    template <auto i, typename T, typename U, U... values>
+    requires (!std::is_same_v<U, bool> && has_value_v<T>)
+    struct exchange<i, T, std::integer_sequence<U, values...>>
+    {
+        template <typename indices>
+        struct impl;
+
+        template <size_t... N>
+        struct impl<std::index_sequence<N...>> : std::type_identity<std::integer_sequence<U, (N == i ? U(typev<T>) : values)...>>
+        {
+        };
+
+        using type = typeof_t<impl<std::make_index_sequence<sizeof...(values)>>>;
+    };
 
     template <auto i, typename T, typename U>
     using exchange_t = typeof_t<exchange<i, T, U>>;
@@ -2057,7 +2496,7 @@ namespace monster
     using exchange_if_t = typeof_t<exchange_if<B, i, T, U>>;
 
     template <auto lower, auto upper, typename T>
-    using range = meta_t<T, std::type_identity<expand_of<T, index_sequence_of_c<upper - lower>, lower>>>;
+    using range = meta_t<T, std::type_identity<pick<T, offset_sequence_t<index_sequence_of_c<upper - lower>, lower>>>>;
 
     template <auto lower, auto upper, typename T>
     using range_t = typeof_t<range<lower, upper, T>>;
@@ -2464,6 +2903,30 @@ namespace monster
         using type = typeof_t<impl<B + 1, E, init, append_t<base_type_t<T>, init>>>;
     };
 
+    template <template <typename, typename> typename F, typename U, U... values, auto B, auto E>
+    requires (!std::is_void_v<value_op_t<F>> && B == 0 && B < E)
+    struct partial_sum<F, std::integer_sequence<U, values...>, B, E>
+    {
+        struct call
+        {
+            template <size_t N>
+            constexpr auto operator()(const std::array<U, N>& a) const
+            {
+                std::array<U, E> result{a[0]};
+
+                for (size_t i = 1; i < E; ++i)
+                    result[i] = value_op_t<F>()(result[i - 1], a[i]);
+
+                return result;
+            }
+        };
+
+        using sums = array_apply_t<call, std::integer_sequence<U, values...>>;
+        using last = decltype(value_op_t<F>()(U(), U()));
+
+        using type = pair_t<int_<static_cast<std::conditional_t<(E > 1), last, U>>(get_v<E - 1, sums>)>, sums>;
+    };
+
     template <template <typename, typename> typename F, typename T, auto B = 0, auto E = sizeof_t_v<T>>
     using partial_sum_t = typeof_t<partial_sum<F, T, B, E>>;
 
@@ -2552,6 +3015,27 @@ namespace monster
         using type = typeof_t<impl<B, E, T>>;
     };
 
+    template <template <typename, typename> typename F, typename T, typename V, V... values, auto B, auto E>
+    requires (!std::is_void_v<value_op_t<F>> && B < E)
+    struct accumulate<F, T, std::integer_sequence<V, values...>, B, E>
+    {
+        struct call
+        {
+            template <size_t N>
+            constexpr auto operator()(const std::array<V, N>& a) const
+            {
+                auto result = value_op_t<F>()(typev<T>, a[B]);
+
+                for (size_t i = B + 1; i < E; ++i)
+                    result = value_op_t<F>()(result, a[i]);
+
+                return result;
+            }
+        };
+
+        using type = array_apply_t<call, std::integer_sequence<V, values...>>;
+    };
+
     template <template <typename, typename> typename F, typename T, typename U, auto B = 0, auto E = sizeof_t_v<U>>
     using accumulate_t = typeof_t<accumulate<F, T, U, B, E>>;
 
@@ -2914,42 +3398,76 @@ namespace monster
         return std::is_same<T, U>() ? 0 : typeindex<T, Args...>() + 1;
     }
 
+    // a type or value that occurs once is found by deducing its position from the bases of the list's index_map,
+    // the map is built once per list and shared with nth_type, repeated or missing ones fall back to a scan
+    template <typename T, size_t N>
+    index_t<N + 1> index_in(const index_type<N, T>*);
+
+    template <typename T>
+    index_t<0> index_in(const void*);
+
     template <typename T, typename U>
-    struct type_index;
+    inline constexpr auto index_in_v = typev<decltype(index_in<T>(std::declval<const U*>()))>;
 
-    template <typename T, template <typename ...> typename U>
-    struct type_index<T, U<>> : index_t<0>
+    template <bool... B>
+    constexpr size_t first_true()
     {
-    };
+        constexpr bool same[] = {B..., true};
 
-    template <typename T, template <typename ...> typename U, typename... Args>
-    struct type_index<T, U<T, Args...>> : index_t<0>
+        size_t i = 0;
+
+        while (!same[i])
+            ++i;
+
+        return i;
+    }
+
+    template <typename T, typename... Args>
+    constexpr size_t type_position()
     {
-    };
+        constexpr auto N = index_in_v<T, index_map<std::index_sequence_for<Args...>, Args...>>;
+
+        if constexpr (N != 0)
+            return N - 1;
+        else
+            return first_true<std::is_same_v<T, Args>...>();
+    }
+
+    template <typename T, typename U>
+    struct type_index;
 
-    template <typename T, template <typename ...> typename U, typename V, typename... Args>
-    struct type_index<T, U<V, Args...>> : index_t<typev<type_index<T, U<Args...>>> + 1>
+    template <typename T, template <typename ...> typename U, typename... Args>
+    struct type_index<T, U<Args...>> : index_t<type_position<T, Args...>()>
     {
     };
 
     template <typename T, typename U>
     inline constexpr auto type_index_v = typev<type_index<T, U>>;
 
-    template <auto value, typename T>
-    struct value_index;
-
-    template <auto value, template <typename, auto ...> typename T, typename U>
-    struct value_index<value, T<U>> : index_t<0>
+    template <typename U, auto value>
+    constexpr bool representable()
     {
-    };
+        if constexpr (std::is_integral_v<U> && std::is_integral_v<decltype(value)>)
+            return std::cmp_equal(+static_cast<U>(value), +value);
+        else
+            return true;
+    }
 
-    template <auto value, template <typename, auto ...> typename T, typename U, auto... values>
-    struct value_index<value, T<U, value, values...>> : index_t<0>
+    // a value that U cannot hold is never found, rather than narrowed into int_<value, U>
+    template <auto value, typename U, auto... values>
+    constexpr size_t value_position()
     {
-    };
+        if constexpr (representable<U, value>())
+            return type_position<int_<static_cast<U>(value), U>, int_<values, U>...>();
+        else
+            return sizeof...(values);
+    }
 
-    template <auto value, template <typename, auto ...> typename T, typename U, auto V, auto... values>
-    struct value_index<value, T<U, V, values...>> : index_t<typev<value_index<value, T<U, values...>>> + 1>
+    template <auto value, typename T>
+    struct value_index;
+
+    template <auto value, template <typename, auto ...> typename T, typename U, auto... values>
+    struct value_index<value, T<U, values...>> : index_t<value_position<value, U, values...>()>
     {
     };
 
@@ -3602,8 +4120,21 @@ namespace monster
     template <size_t N, typename T, auto... values>
     struct clamp<N, std::integer_sequence<T, values...>>
     {
-        using indices = std::integer_sequence<T, values...>;
-        using type = prepend_t<typeof_t<clamp<N - 1, pop_front_t<indices>>>, get<0, indices>>;
+        struct call
+        {
+            template <size_t M>
+            constexpr auto operator()(const std::array<T, M>& a) const
+            {
+                std::array<T, N> result{};
+
+                for (size_t i = 0; i != N; ++i)
+                    result[i] = a[i];
+
+                return result;
+            }
+        };
+
+        using type = array_apply_t<call, std::integer_sequence<T, values...>>;
     };
 
     template <size_t N, typename T>
@@ -3704,13 +4235,19 @@ namespace monster
     template <auto i, auto j, auto k, typename T>
     struct rotate
     {
-        template <typename indices, auto V = 0>
-        using impl = expand_t<element, T, indices, V>;
+        // [0, i) [j, k) [i, j) [k, n)
+        template <size_t p>
+        static constexpr size_t source = p < i || p >= k ? p : p < i + k - j ? p - i + j : p - k + j;
 
-        template <size_t p, size_t q>
-        using extend = impl<index_sequence_of_c<q - p>, p>;
+        template <typename indices>
+        struct impl;
+
+        template <size_t... N>
+        struct impl<std::index_sequence<N...>> : pick<T, std::index_sequence<source<N>...>>
+        {
+        };
 
-        using type = concat_t<range_t<0, i, T>, extend<j, k>, extend<i, j>, range_t<k, sizeof_t_v<T>, T>>;
+        using type = typeof_t<impl<index_sequence_of_t<T>>>;
     };
 
     template <auto i, auto j, auto k, typename T>
@@ -4644,17 +5181,22 @@ namespace monster
     template <auto N, typename... Args>
     struct cycle
     {
-        template <int i, int j, typename T>
-        struct impl : impl<i + 1, j, append_t<T, Args...>>
+        using base = base_type_t<store_t<alias_t<Args...>>>;
+        using unit = append_t<base, Args...>;
+
+        template <auto n, bool = (n > 1)>
+        struct impl
         {
+            using half = typeof_t<impl<n / 2>>;
+            using type = type_if<n % 2 == 0, concat<half, half>, concat<half, half, unit>>;
         };
 
-        template <int j, typename T>
-        struct impl<j, j, T> : std::type_identity<T>
+        template <auto n>
+        struct impl<n, false> : std::conditional<n == 1, unit, base>
         {
         };
 
-        using type = typeof_t<impl<0, N, base_type_t<store_t<alias_t<Args...>>>>>;
+        using type = typeof_t<impl<N>>;
     };
 
     template <auto N, typename... Args>
@@ -4706,10 +5248,13 @@ namespace monster
         template <size_t i, size_t j, typename>
         struct impl;
 
+        using X = indexed_t<T>;
+        using Y = indexed_t<U>;
+
         template <size_t i, size_t j, auto... N>
         struct impl<i, j, std::index_sequence<N...>>
         {
-            using conc = concat_t<store_t<element_t<i, T>, element_t<N, U>>...>;
+            using conc = concat_t<store_t<element_t<i, X>, element_t<N, Y>>...>;
             using type = concat_t<conc, typeof_t<impl<i + 1, j, std::index_sequence<N...>>>>;
         };
 
@@ -4767,6 +5312,38 @@ namespace monster
         using type = typeof_t<impl<0, 0, M, N, base_type_t<T>>>;
     };
 
+    template <typename U, U... u, typename V, V... v, auto M, auto N>
+    requires (M == sizeof...(u) && N == sizeof...(v) && M > 0 && N > 0)
+    struct large_number_multiplier<std::integer_sequence<U, u...>, std::integer_sequence<V, v...>, M, N>
+    {
+        struct call
+        {
+            constexpr auto operator()(const std::array<U, M>& a, const std::array<V, N>& b) const
+            {
+                std::array<U, M + N> digits{};
+
+                for (size_t i = 0; i != M; ++i)
+                    for (size_t j = 0; j != N; ++j)
+                        digits[i + j] += a[M - i - 1] * b[N - j - 1];
+
+                for (size_t k = 0; k + 1 != M + N; ++k)
+                {
+                    digits[k + 1] += digits[k] / 10;
+                    digits[k] %= 10;
+                }
+
+                std::pair<std::array<U, M + N>, size_t> result{{}, M + N - (digits[M + N - 1] == 0)};
+
+                for (size_t k = 0; k != result.second; ++k)
+                    result.first[k] = digits[result.second - k - 1];
+
+                return result;
+            }
+        };
+
+        using type = array_apply_t<call, std::integer_sequence<U, u...>, std::integer_sequence<V, v...>>;
+    };
+
     template <typename T, typename U, auto M = sizeof_t_v<T>, auto N = sizeof_t_v<U>>
     using large_number_multiplier_t = typeof_t<large_number_multiplier<T, U, M, N>>;
 
@@ -5407,8 +5984,11 @@ namespace monster
             static constexpr auto half = len - len / 2;
             static constexpr auto index = first_not_of_v<comparator, left_partition, m, m + half>;
 
-            using right_partition = partition_adaptive<index, r, half, size, left_partition, comparator>;
-            using right_split = type_if<half, right_partition, index_upper<index, left_partition>>;
+            // the elements skipped by first_not_of are already in place, only the rest is partitioned
+            static constexpr auto rest = half - (index - m);
+
+            using right_partition = partition_adaptive<index, r, rest, size, left_partition, comparator>;
+            using right_split = type_if<rest != 0, right_partition, index_upper<index, left_partition>>;
 
             static constexpr auto b = typev<left_split>;
             static constexpr auto e = typev<right_split>;
@@ -5494,6 +6074,15 @@ namespace monster
         using type = typeof_t<impl<0, sizeof_t_v<T>, n, T>>;
     };
 
+    template <size_t n, typename U, U... values, template <typename, typename> typename comparator>
+    requires (key_order_v<comparator> != 0 && 0 < n && n <= sizeof...(values))
+    struct select<n, std::integer_sequence<U, values...>, comparator>
+    {
+        static constexpr auto order = sort_permutation<key_order_v<comparator>>(array_of_v<std::integer_sequence<U, values...>>);
+
+        using type = int_<array_of_v<std::integer_sequence<U, values...>>[order[n - 1]], U>;
+    };
+
     template <size_t n, typename T, template <typename, typename> typename comparator = less_equal_t>
     using select_t = typeof_t<select<n, T, comparator>>;
 
@@ -5557,6 +6146,52 @@ namespace monster
     template <typename T, template <typename, typename> typename comparator = less_equal_t>
     using select_sort_t = sort_t<select_sort, T, comparator>;
 
+    // sorts the values in ascending order by the decimal digits of their distance to the minimum
+    struct radix_sorter
+    {
+        template <typename U, size_t N>
+        constexpr auto operator()(std::array<U, N> a) const
+        {
+            using V = std::make_unsigned_t<U>;
+
+            if constexpr (N > 1)
+            {
+                U low = a[0];
+                U high = a[0];
+
+                for (auto x : a)
+                {
+                    low = x < low ? x : low;
+                    high = high < x ? x : high;
+                }
+
+                std::array<U, N> next{};
+
+                for (V exp = 1; ; exp *= 10)
+                {
+                    auto digit = [&](U x) { return V(V(x) - V(low)) / exp % 10; };
+                    std::array<size_t, 10> count{};
+
+                    for (auto x : a)
+                        ++count[digit(x)];
+
+                    for (size_t d = 1; d != 10; ++d)
+                        count[d] += count[d - 1];
+
+                    for (size_t i = N; i-- != 0;)
+                        next[--count[digit(a[i])]] = a[i];
+
+                    a = next;
+
+                    if (V(V(high) - V(low)) / exp < 10)
+                        break;
+                }
+            }
+
+            return a;
+        }
+    };
+
     template <typename T, template <typename, typename> typename comparator = less_t, int exp = 0, int base = 0>
     struct counting_sort
     {
@@ -5611,6 +6246,13 @@ namespace monster
         using type = normalize_t<typeof_t<impl>, normalize_v<T>>;
     };
 
+    template <typename U, U... values, template <typename, typename> typename comparator>
+    requires (!std::is_same_v<U, bool>)
+    struct counting_sort<std::integer_sequence<U, values...>, comparator, 0, 0> :
+    array_apply<radix_sorter, std::integer_sequence<U, values...>>
+    {
+    };
+
     template <typename T, template <typename, typename> typename comparator = less_t>
     using counting_sort_t = sort_t<counting_sort, T, comparator>;
 
@@ -5633,6 +6275,13 @@ namespace monster
         using type = typeof_t<impl<1, T>>;
     };
 
+    template <typename U, U... values, template <typename, typename> typename comparator>
+    requires (!std::is_same_v<U, bool>)
+    struct radix_sort<std::integer_sequence<U, values...>, comparator> :
+    array_apply<radix_sorter, std::integer_sequence<U, values...>>
+    {
+    };
+
     template <typename T, template <typename, typename> typename comparator = less_t>
     using radix_sort_t = sort_t<radix_sort, T, comparator>;
 
@@ -5667,7 +6316,10 @@ namespace monster
     template <typename T, typename U, auto m = sizeof_t_v<T> + 1, auto n = sizeof_t_v<U> + 1>
     struct edit_distance
     {
-        static constexpr auto B = is_tuple_v<T>;
+        static constexpr auto B = is_tuple_v<unindexed_t<T>>;
+
+        using X = indexed_t<T>;
+        using Y = indexed_t<U>;
 
         template <size_t i, size_t j, size_t k, typename V, bool>
         struct next
@@ -5685,7 +6337,7 @@ namespace monster
                 using type = sub_t<k, 1 + min_v<value, get_v<k - n - 1, W>>, W>;
             };
 
-            using type = typeof_t<impl<V, typev<is_same<i - 1, j - 1, T, U, B>>>>;
+            using type = typeof_t<impl<V, typev<is_same<i - 1, j - 1, X, Y, B>>>>;
         };
 
         template <size_t i, size_t j, size_t k, typename V>
@@ -5717,41 +6369,73 @@ namespace monster
         static constexpr auto value = get_v<m * n - 1, type>;
     };
 
+    template <typename U, U... u, typename V, V... v, auto m, auto n>
+    requires (m == sizeof...(u) + 1 && n == sizeof...(v) + 1)
+    struct edit_distance<std::integer_sequence<U, u...>, std::integer_sequence<V, v...>, m, n>
+    {
+        struct call
+        {
+            constexpr auto operator()(const std::array<U, m - 1>& a, const std::array<V, n - 1>& b) const
+            {
+                std::array<int, m * n> table{};
+
+                for (size_t j = 0; j != n; ++j)
+                    table[j] = j;
+
+                for (size_t i = 1; i != m; ++i)
+                {
+                    int* prev = table.data() + (i - 1) * n;
+                    int* curr = prev + n;
+
+                    curr[0] = i;
+
+                    for (size_t j = 1; j != n; ++j)
+                    {
+                        int lhs = curr[j - 1] < prev[j] ? curr[j - 1] : prev[j];
+                        int rhs = a[i - 1] == b[j - 1] ? prev[j - 1] - 1 : prev[j - 1];
+
+                        curr[j] = 1 + (lhs < rhs ? lhs : rhs);
+                    }
+                }
+
+                return table;
+            }
+        };
+
+        using type = array_apply_t<call, std::integer_sequence<U, u...>, std::integer_sequence<V, v...>>;
+        static constexpr auto value = array_apply_v<call, std::integer_sequence<U, u...>, std::integer_sequence<V, v...>>[m * n - 1];
+    };
+
+    template <typename T, typename U, auto m, auto n>
+    requires (is_indexed_v<T> || is_indexed_v<U>)
+    struct edit_distance<T, U, m, n> : edit_distance<unindexed_t<T>, unindexed_t<U>, m, n>
+    {
+    };
+
     template <typename T, typename U>
     inline constexpr auto edit_distance_v = typev<edit_distance<T, U>>;
 
     template <int p, int q, int m = p + 1, int n = q + 1>
     struct binomial_coeff
     {
-        template <int k, typename T, bool>
-        struct next : sub<k, 1, T>
-        {
-        };
-
-        template <int k, typename T>
-        struct next<k, T, false> : sub<k, get_v<k - n - 1, T> + get_v<k - n, T>, T>
-        {
-        };
-
-        template <int i, int j, int k, int l, typename T>
-        struct impl
+        struct call
         {
-            using cond = typeof_t<next<i * n + j, T, j == 0 || j == i>>;
-            using type = typeof_t<impl<i, j + 1, k, min_v<i, n - 1> + 1, cond>>;
-        };
+            constexpr auto operator()() const
+            {
+                std::array<int, m * n> table{};
 
-        template <int i, int k, int l, typename T>
-        struct impl<i, l, k, l, T> : impl<i + 1, 0, k, l, T>
-        {
-        };
+                for (int i = 0; i != m; ++i)
+                {
+                    for (int j = 0; j <= i && j != n; ++j)
+                        table[i * n + j] = j == 0 || j == i ? 1 : table[(i - 1) * n + j - 1] + table[(i - 1) * n + j];
+                }
 
-        template <int k, int l, typename T>
-        struct impl<k, 0, k, l, T> : std::type_identity<T>
-        {
+                return table;
+            }
         };
 
-        using type = typeof_t<impl<0, 0, m, min_v<0, n - 1> + 1, fill_c<m * n, 0>>>;
-        static constexpr auto value = get_v<m * n - 1, type>;
+        using type = array_apply_t<call>;
+        static constexpr auto value = array_apply_v<call>[m * n - 1];
     };
 
     template <int p, int q>
@@ -6108,7 +6792,9 @@ namespace monster
             using first = element_t<i, left>;
             using second = element_t<j, right>;
 
-            static constexpr auto value = typev<comparator<first, second>>;
+            // the sentinels only keep the lookups in range, an exhausted half is never taken from,
+            // since a maximum that occurs in the input would otherwise compare equal to them
+            static constexpr auto value = j == r - q || (i != q - p + 1 && typev<comparator<first, second>>);
             using swap = exchange_t<k, std::conditional_t<value, first, second>, U>;
 
             using type = typeof_t<assign<i + value, j + !value, k + 1, l, swap>>;
@@ -6247,16 +6933,64 @@ namespace monster
     template <typename T, template <typename, typename> typename comparator = less_t>
     using heap_sort_t = sort_t<heap_sort, T, comparator>;
 
-    template <typename P, typename T, auto N = sizeof_t_v<P>, auto value = is_tuple_v<P>>
+    template <typename T, typename U, template <typename, typename> typename comparator>
+    struct sort_by_keys;
+
+    template <typename T, typename U, U... keys, template <typename, typename> typename comparator>
+    struct sort_by_keys<T, std::integer_sequence<U, keys...>, comparator>
+    {
+        static constexpr std::array<U, sizeof...(keys)> array = {keys...};
+        static constexpr auto order = sort_permutation<key_order_v<comparator>>(array);
+
+        template <typename indices>
+        struct impl;
+
+        template <size_t... N>
+        struct impl<std::index_sequence<N...>> : pick<T, std::index_sequence<order[N]...>>
+        {
+        };
+
+        using type = typeof_t<impl<std::make_index_sequence<sizeof...(keys)>>>;
+    };
+
+    // sorts the keys that the builtin comparators compare in a constexpr function and picks
+    // the elements in the resulting order, other comparators fall back to stable_sort
+    template <typename T, template <typename, typename> typename comparator = less_t>
+    struct fast_sort : stable_sort<T, comparator>
+    {
+    };
+
+    template <typename U, U... values, template <typename, typename> typename comparator>
+    requires (key_order_v<comparator> != 0)
+    struct fast_sort<std::integer_sequence<U, values...>, comparator> :
+    sort_by_keys<std::integer_sequence<U, values...>, std::integer_sequence<U, values...>, comparator>
+    {
+    };
+
+    template <typename... Args, template <typename, typename> typename comparator>
+    requires (key_order_v<comparator> != 0 && sizeof...(Args) > 0)
+    struct fast_sort<std::tuple<Args...>, comparator> :
+    sort_by_keys<std::tuple<Args...>, std::integer_sequence<std::common_type_t<
+    std::remove_cv_t<decltype(sizeof_t_v<Args>)>...>, sizeof_t_v<Args>...>, comparator>
+    {
+    };
+
+    template <typename T, template <typename, typename> typename comparator = less_t>
+    using fast_sort_t = sort_t<fast_sort, T, comparator>;
+
+    template <typename P, typename T, auto N = sizeof_t_v<P>, auto value = is_tuple_v<unindexed_t<P>>>
     struct kmp
     {
+        using X = indexed_t<P>;
+        using Y = indexed_t<T>;
+
         template <typename U, typename V, typename W, int k, int q>
         struct next
         {
             using nega = std::negation<is_same<k, q, U, V, value>>;
             using cond = std::conditional_t<0 < k, nega, std::false_type>;
 
-            using curr = std::conditional_t<typev<cond>, get<k, W>, int_<k>>;
+            using curr = std::conditional_t<typev<cond>, get<k - 1, W>, int_<k>>;
             using type = type_if<typev<cond>, next<U, V, W, typev<curr>, q>, int_<k>>;
         };
 
@@ -6264,7 +6998,7 @@ namespace monster
         struct impl
         {
             using lhs = std::conditional_t<B, U, V>;
-            using rhs = std::conditional_t<B, V, T>;
+            using rhs = std::conditional_t<B, V, Y>;
 
             static constexpr auto m = typev<typeof_t<next<lhs, rhs, W, k, q>>>;
             static constexpr int n = m + typev<is_same<m, q, lhs, rhs, value>>;
@@ -6282,8 +7016,57 @@ namespace monster
             using type = std::conditional_t<B, W, U>;
         };
 
-        using call = typeof_t<impl<1, P, P, fill_c<N, 0>, 0, 1, N>>;
-        using type = typeof_t<impl<0, std::index_sequence<>, P, call, 0, 0, sizeof_t_v<T>>>;
+        using call = typeof_t<impl<1, X, X, fill_c<N, 0>, 0, 1, N>>;
+        using type = typeof_t<impl<0, std::index_sequence<>, X, indexed<call>, 0, 0, sizeof_t_v<T>>>;
+    };
+
+    template <typename U, U... p, typename V, V... t, auto N, auto value>
+    requires (N == sizeof...(p) && N > 0)
+    struct kmp<std::integer_sequence<U, p...>, std::integer_sequence<V, t...>, N, value>
+    {
+        struct call
+        {
+            template <size_t M>
+            constexpr auto operator()(const std::array<U, N>& pattern, const std::array<V, M>& text) const
+            {
+                std::array<size_t, N> prefix{};
+
+                for (size_t q = 1, k = 0; q != N; ++q)
+                {
+                    while (k > 0 && pattern[k] != pattern[q])
+                        k = prefix[k - 1];
+
+                    k += pattern[k] == pattern[q];
+                    prefix[q] = k;
+                }
+
+                std::pair<std::array<size_t, M>, size_t> result{};
+
+                for (size_t q = 0, k = 0; q != M; ++q)
+                {
+                    while (k > 0 && pattern[k] != text[q])
+                        k = prefix[k - 1];
+
+                    k += pattern[k] == text[q];
+
+                    if (k == N)
+                    {
+                        result.first[result.second++] = q + 1 - N;
+                        k = prefix[k - 1];
+                    }
+                }
+
+                return result;
+            }
+        };
+
+        using type = array_apply_t<call, std::integer_sequence<U, p...>, std::integer_sequence<V, t...>>;
+    };
+
+    template <typename P, typename T, auto N, auto value>
+    requires (is_indexed_v<P> || is_indexed_v<T>)
+    struct kmp<P, T, N, value> : kmp<unindexed_t<P>, unindexed_t<T>, N, value>
+    {
     };
 
     template <typename P, typename T>
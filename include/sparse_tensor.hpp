@@ -0,0 +1,453 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+#ifndef SPARSE_TENSOR_HPP
+#define SPARSE_TENSOR_HPP
+
+#include <array>
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+#include "tensor.hpp"
+
+// Sparse tensors only store their non-zero elements, they share the equal extents of the dense tensor.
+//
+//     coo_tensor    a list of (coordinate, value) pairs, cheap to build in any order
+//     csr_tensor    a compressed sparse row matrix, fast row traversal and matrix products
+//     csf_tensor    a compressed sparse fiber tree, CSR generalized to any rank
+//
+// csr_tensor and csf_tensor are built from a coo_tensor or directly from a dense tensor.
+
+namespace monster
+{
+    template <size_t I = 0, typename E, size_t N>
+    decltype(auto) tensor_at(E& t, const std::array<size_t, N>& coordinate)
+    {
+        if constexpr(I + 1 == N)
+            return (t[coordinate[I]]);
+        else
+            return tensor_at<I + 1>(t[coordinate[I]], coordinate);
+    }
+
+    template <typename T, size_t N>
+    class coo_tensor
+    {
+        public:
+            using value_type = T;
+            using coordinate = std::array<size_t, N>;
+            static constexpr size_t rank = N;
+
+            explicit coo_tensor(size_t size = 3) : extent(size)
+            {
+            }
+
+            template <typename Alloc>
+            explicit coo_tensor(const tensor<T, N, Alloc>& t);
+
+            void insert(const coordinate& c, const T& value)
+            {
+                if (std::any_of(c.begin(), c.end(), [this](size_t i){ return i >= extent; }))
+                    throw std::out_of_range("coo_tensor: coordinate out of range");
+
+                coords.push_back(c);
+                vals.push_back(value);
+            }
+
+            void canonicalize();
+
+            tensor<T, N> to_dense() const;
+
+            template <typename F>
+            void for_each(F&& f) const
+            {
+                for (size_t i = 0; i != vals.size(); ++i)
+                     f(coords[i], vals[i]);
+            }
+
+            size_t size() const
+            {
+                return extent;
+            }
+
+            size_t nnz() const
+            {
+                return vals.size();
+            }
+
+            const std::vector<coordinate>& coordinates() const
+            {
+                return coords;
+            }
+
+            const std::vector<T>& values() const
+            {
+                return vals;
+            }
+
+            virtual ~coo_tensor() = default;
+
+        private:
+            template <size_t I, typename E>
+            void gather(const E& e, coordinate& c);
+
+            size_t extent;
+            std::vector<coordinate> coords;
+            std::vector<T> vals;
+    };
+
+    template <typename T, size_t N>
+    template <typename Alloc>
+    coo_tensor<T, N>::coo_tensor(const tensor<T, N, Alloc>& t) : extent(t.size())
+    {
+        coordinate c{};
+        gather<0>(t, c);
+    }
+
+    template <typename T, size_t N>
+    template <size_t I, typename E>
+    void coo_tensor<T, N>::gather(const E& e, coordinate& c)
+    {
+        for (size_t k = 0; k != e.size(); ++k)
+        {
+             c[I] = k;
+             if constexpr(I + 1 == N)
+             {
+                 if (e[k] != T())
+                     insert(c, e[k]);
+             }
+             else
+                 gather<I + 1>(e[k], c);
+        }
+    }
+
+    // sorts the elements by coordinate, sums duplicates and drops explicit zeros
+    template <typename T, size_t N>
+    void coo_tensor<T, N>::canonicalize()
+    {
+        std::vector<size_t> order(vals.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t i, size_t j){ return coords[i] < coords[j]; });
+
+        std::vector<coordinate> c;
+        std::vector<T> v;
+
+        c.reserve(order.size());
+        v.reserve(order.size());
+
+        for (auto i : order)
+        {
+             if (!c.empty() && c.back() == coords[i])
+                 v.back() += vals[i];
+             else
+             {
+                 if (!v.empty() && v.back() == T())
+                 {
+                     c.pop_back();
+                     v.pop_back();
+                 }
+                 c.push_back(coords[i]);
+                 v.push_back(vals[i]);
+             }
+        }
+
+        if (!v.empty() && v.back() == T())
+        {
+            c.pop_back();
+            v.pop_back();
+        }
+
+        coords = std::move(c);
+        vals = std::move(v);
+    }
+
+    template <typename T, size_t N>
+    tensor<T, N> coo_tensor<T, N>::to_dense() const
+    {
+        tensor<T, N> t(extent);
+        for_each([&t](const coordinate& c, const T& value){ tensor_at(t, c) += value; });
+        return t;
+    }
+
+    template <typename T>
+    class csr_tensor
+    {
+        public:
+            using value_type = T;
+            using coordinate = std::array<size_t, 2>;
+            static constexpr size_t rank = 2;
+
+            explicit csr_tensor(const coo_tensor<T, 2>& coo);
+
+            template <typename Alloc>
+            explicit csr_tensor(const tensor<T, 2, Alloc>& t) : csr_tensor(coo_tensor<T, 2>(t))
+            {
+            }
+
+            tensor<T, 2> to_dense() const;
+
+            template <typename F>
+            void for_each(F&& f) const
+            {
+                for (size_t i = 0; i != extent; ++i)
+                     for (size_t j = rows[i]; j != rows[i + 1]; ++j)
+                          f(coordinate{i, cols[j]}, vals[j]);
+            }
+
+            size_t size() const
+            {
+                return extent;
+            }
+
+            size_t nnz() const
+            {
+                return vals.size();
+            }
+
+            const std::vector<size_t>& row_offsets() const
+            {
+                return rows;
+            }
+
+            const std::vector<size_t>& columns() const
+            {
+                return cols;
+            }
+
+            const std::vector<T>& values() const
+            {
+                return vals;
+            }
+
+            virtual ~csr_tensor() = default;
+
+        private:
+            size_t extent;
+            std::vector<size_t> rows;
+            std::vector<size_t> cols;
+            std::vector<T> vals;
+    };
+
+    template <typename T>
+    csr_tensor<T>::csr_tensor(const coo_tensor<T, 2>& coo) : extent(coo.size()), rows(coo.size() + 1)
+    {
+        auto c = coo;
+        c.canonicalize();
+
+        cols.reserve(c.nnz());
+        vals = c.values();
+
+        for (auto& [i, j] : c.coordinates())
+        {
+             ++rows[i + 1];
+             cols.push_back(j);
+        }
+
+        std::partial_sum(rows.begin(), rows.end(), rows.begin());
+    }
+
+    template <typename T>
+    tensor<T, 2> csr_tensor<T>::to_dense() const
+    {
+        tensor<T, 2> t(extent);
+        for_each([&t](const coordinate& c, const T& value){ t[c[0]][c[1]] = value; });
+        return t;
+    }
+
+    // level l holds one node per distinct coordinate prefix of length l + 1, the children of node i
+    // of level l are the nodes offsets[l][i] to offsets[l][i + 1] of level l + 1, values belong to the leaves
+    template <typename T, size_t N>
+    class csf_tensor
+    {
+        public:
+            using value_type = T;
+            using coordinate = std::array<size_t, N>;
+            static constexpr size_t rank = N;
+
+            explicit csf_tensor(const coo_tensor<T, N>& coo);
+
+            template <typename Alloc>
+            explicit csf_tensor(const tensor<T, N, Alloc>& t) : csf_tensor(coo_tensor<T, N>(t))
+            {
+            }
+
+            tensor<T, N> to_dense() const;
+
+            template <typename F>
+            void for_each(F&& f) const
+            {
+                coordinate c{};
+                visit<0>(0, ids[0].size(), c, f);
+            }
+
+            size_t size() const
+            {
+                return extent;
+            }
+
+            size_t nnz() const
+            {
+                return vals.size();
+            }
+
+            const std::vector<size_t>& indices(size_t level) const
+            {
+                return ids[level];
+            }
+
+            const std::vector<size_t>& offsets(size_t level) const
+            {
+                return ptrs[level];
+            }
+
+            const std::vector<T>& values() const
+            {
+                return vals;
+            }
+
+            virtual ~csf_tensor() = default;
+
+        private:
+            template <size_t L, typename F>
+            void visit(size_t first, size_t last, coordinate& c, F& f) const;
+
+            size_t extent;
+            std::array<std::vector<size_t>, N> ids;
+            std::array<std::vector<size_t>, N - 1> ptrs;
+            std::vector<T> vals;
+    };
+
+    template <typename T, size_t N>
+    csf_tensor<T, N>::csf_tensor(const coo_tensor<T, N>& coo) : extent(coo.size())
+    {
+        auto c = coo;
+        c.canonicalize();
+
+        auto& coords = c.coordinates();
+        vals = c.values();
+
+        for (size_t e = 0; e != coords.size(); ++e)
+        {
+             size_t d = 0;
+             if (e != 0)
+                 while (coords[e][d] == coords[e - 1][d])
+                        ++d;
+
+             for (size_t l = d; l != N; ++l)
+             {
+                  if (l + 1 != N)
+                      ptrs[l].push_back(ids[l + 1].size());
+                  ids[l].push_back(coords[e][l]);
+             }
+        }
+
+        for (size_t l = 0; l + 1 != N; ++l)
+             ptrs[l].push_back(ids[l + 1].size());
+    }
+
+    template <typename T, size_t N>
+    template <size_t L, typename F>
+    void csf_tensor<T, N>::visit(size_t first, size_t last, coordinate& c, F& f) const
+    {
+        for (size_t i = first; i != last; ++i)
+        {
+             c[L] = ids[L][i];
+             if constexpr(L + 1 == N)
+                 f(static_cast<const coordinate&>(c), vals[i]);
+             else
+                 visit<L + 1>(ptrs[L][i], ptrs[L][i + 1], c, f);
+        }
+    }
+
+    template <typename T, size_t N>
+    tensor<T, N> csf_tensor<T, N>::to_dense() const
+    {
+        tensor<T, N> t(extent);
+        for_each([&t](const coordinate& c, const T& value){ tensor_at(t, c) = value; });
+        return t;
+    }
+
+    // sparse matrix times dense vector
+    template <typename T, typename Alloc>
+    tensor<T, 1> operator*(const csr_tensor<T>& a, const tensor<T, 1, Alloc>& x)
+    {
+        auto& rows = a.row_offsets();
+        auto& cols = a.columns();
+        auto& vals = a.values();
+
+        if (x.size() != a.size())
+            throw std::invalid_argument("csr_tensor: dimension mismatch");
+
+        tensor<T, 1> y(a.size());
+        for (size_t i = 0; i != a.size(); ++i)
+        {
+             T sum = T();
+             for (size_t j = rows[i]; j != rows[i + 1]; ++j)
+                  sum += vals[j] * x[cols[j]];
+             y[i] = sum;
+        }
+
+        return y;
+    }
+
+    // sparse matrix times dense matrix, every non-zero scales one contiguous row of b
+    template <typename T, typename Alloc>
+    tensor<T, 2> operator*(const csr_tensor<T>& a, const tensor<T, 2, Alloc>& b)
+    {
+        auto& rows = a.row_offsets();
+        auto& cols = a.columns();
+        auto& vals = a.values();
+
+        size_t n = b.size();
+        for (size_t k = 0; k != n; ++k)
+             if (b[k].size() != n)
+                 throw std::invalid_argument("csr_tensor: dimension mismatch");
+
+        if (n != a.size())
+            throw std::invalid_argument("csr_tensor: dimension mismatch");
+
+        tensor<T, 2> c(a.size());
+
+        for (size_t i = 0; i != a.size(); ++i)
+        {
+             auto out = c[i].data();
+             for (size_t j = rows[i]; j != rows[i + 1]; ++j)
+             {
+                  auto v = vals[j];
+                  auto in = b[cols[j]].data();
+                  for (size_t k = 0; k != n; ++k)
+                       out[k] += v * in[k];
+             }
+        }
+
+        return c;
+    }
+
+    // sparse tensor times dense vector along the last mode
+    template <typename T, size_t N, typename Alloc>
+    requires (N > 1)
+    tensor<T, N - 1> operator*(const csf_tensor<T, N>& a, const tensor<T, 1, Alloc>& x)
+    {
+        if (x.size() != a.size())
+            throw std::invalid_argument("csf_tensor: dimension mismatch");
+
+        tensor<T, N - 1> y(a.size());
+
+        a.for_each([&](const std::array<size_t, N>& c, const T& value)
+        {
+            std::array<size_t, N - 1> prefix;
+            std::copy(c.begin(), c.end() - 1, prefix.begin());
+            tensor_at(y, prefix) += value * x[c[N - 1]];
+        });
+
+        return y;
+    }
+}
+
+#endif
@@ -10,38 +10,229 @@
 #ifndef TENSOR_HPP
 #define TENSOR_HPP
 
+#include <memory>
 #include <vector>
 #include <cstddef>
+#include <concepts>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
 
 namespace monster
 {
+    template <typename T, size_t N, typename Alloc = std::allocator<T>>
+    class tensor;
+
+    template <typename T>
+    struct is_tensor : std::false_type
+    {
+    };
+
+    template <typename T, size_t N, typename Alloc>
+    struct is_tensor<tensor<T, N, Alloc>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    inline constexpr auto is_tensor_v = is_tensor<std::remove_cvref_t<T>>::value;
+
+    // expression nodes are lightweight views that are evaluated lazily, element by element,
+    // when they are assigned to a tensor, so a + b * c never materializes a temporary tensor
+
+    template <typename T>
+    struct is_tensor_expression : std::false_type
+    {
+    };
+
+    template <typename T>
+    inline constexpr auto is_tensor_expression_v = is_tensor_expression<std::remove_cvref_t<T>>::value;
+
+    template <typename T>
+    concept tensor_operand = is_tensor_v<T> || is_tensor_expression_v<T>;
+
+    template <typename T>
+    struct tensor_traits
+    {
+        using value_type = typename std::remove_cvref_t<T>::value_type;
+        static constexpr size_t rank = std::remove_cvref_t<T>::rank;
+    };
+
+    template <typename T>
+    using tensor_value_t = typename tensor_traits<T>::value_type;
+
+    template <typename T>
+    inline constexpr auto tensor_rank_v = tensor_traits<T>::rank;
+
+    // tensors are held by reference, expression nodes and scalars by value
+    template <typename T>
+    using tensor_operand_t = std::conditional_t<is_tensor_v<T>, const std::remove_cvref_t<T>&, std::remove_cvref_t<T>>;
+
+    template <typename T, size_t N>
+    class tensor_scalar
+    {
+        public:
+            using value_type = T;
+            static constexpr size_t rank = N;
+
+            explicit tensor_scalar(const T& value) : value(value)
+            {
+            }
+
+            decltype(auto) operator[](size_t) const
+            {
+                if constexpr(N == 1)
+                    return value;
+                else
+                    return tensor_scalar<T, N - 1>(value);
+            }
+
+        private:
+            T value;
+    };
+
     template <typename T, size_t N>
+    struct is_tensor_expression<tensor_scalar<T, N>> : std::true_type
+    {
+    };
+
+    template <typename F, typename E>
+    class tensor_unary
+    {
+        public:
+            using value_type = std::invoke_result_t<F, tensor_value_t<E>>;
+            static constexpr size_t rank = tensor_rank_v<E>;
+
+            explicit tensor_unary(tensor_operand_t<E> e) : e(e)
+            {
+            }
+
+            auto operator[](size_t k) const
+            {
+                if constexpr(rank == 1)
+                    return F()(e[k]);
+                else
+                    return tensor_unary<F, decltype(e[k])>(e[k]);
+            }
+
+            size_t size() const
+            {
+                return e.size();
+            }
+
+        private:
+            tensor_operand_t<E> e;
+    };
+
+    template <typename F, typename E>
+    struct is_tensor_expression<tensor_unary<F, E>> : std::true_type
+    {
+    };
+
+    template <typename F, typename L, typename R>
+    class tensor_binary
+    {
+        public:
+            using value_type = std::invoke_result_t<F, tensor_value_t<L>, tensor_value_t<R>>;
+            static constexpr size_t rank = tensor_rank_v<L>;
+
+            // every level is checked as it is reached, so ragged operands are caught row by row
+            tensor_binary(tensor_operand_t<L> lhs, tensor_operand_t<R> rhs) : lhs(lhs), rhs(rhs)
+            {
+                if constexpr(!is_scalar<L> && !is_scalar<R>)
+                    if (lhs.size() != rhs.size())
+                        throw std::invalid_argument("tensor_binary: extent mismatch");
+            }
+
+            auto operator[](size_t k) const
+            {
+                if constexpr(rank == 1)
+                    return F()(lhs[k], rhs[k]);
+                else
+                    return tensor_binary<F, decltype(lhs[k]), decltype(rhs[k])>(lhs[k], rhs[k]);
+            }
+
+            size_t size() const
+            {
+                if constexpr(is_scalar<L>)
+                    return rhs.size();
+                else
+                    return lhs.size();
+            }
+
+        private:
+            template <typename T>
+            static constexpr auto is_scalar = !is_tensor_v<T> && !requires (const T& t) { t.size(); };
+
+            tensor_operand_t<L> lhs;
+            tensor_operand_t<R> rhs;
+    };
+
+    template <typename F, typename L, typename R>
+    struct is_tensor_expression<tensor_binary<F, L, R>> : std::true_type
+    {
+    };
+
+    // every level of a tensor allocates from a copy of the same allocator, rebound to its element type,
+    // so a stateful allocator such as an arena or a std::pmr::polymorphic_allocator covers the whole tensor
+    template <typename T, size_t N, typename Alloc>
     class tensor
     {
         public:
-            explicit tensor(size_t size = 3);
+            using value_type = T;
+            static constexpr size_t rank = N;
+
+            explicit tensor(size_t size = 3, const Alloc& alloc = Alloc());
+
+            template <typename E>
+            requires is_tensor_expression_v<E> && (tensor_rank_v<E> == N)
+            tensor(const E& e, const Alloc& alloc = Alloc());
 
-            tensor<T, N-1>& operator[](size_t k);
-            const tensor<T, N-1>& operator[](size_t k) const;
+            template <typename E>
+            requires is_tensor_expression_v<E> && (tensor_rank_v<E> == N)
+            tensor& operator=(const E& e);
+
+            tensor<T, N-1, Alloc>& operator[](size_t k);
+            const tensor<T, N-1, Alloc>& operator[](size_t k) const;
 
             void resize(size_t size);
 
+            template <typename F>
+            void resize(size_t size, F&& for_each);
+
             size_t size() const 
             { 
                 return elements.size();
             }
 
+            Alloc get_allocator() const
+            {
+                return Alloc(elements.get_allocator());
+            }
+
             virtual ~tensor() = default;
 
         private:
-            std::vector<tensor<T, N-1>> elements;
+            using element_type = tensor<T, N-1, Alloc>;
+
+            std::vector<element_type, typename std::allocator_traits<Alloc>::template rebind_alloc<element_type>> elements;
     };
 
-    template <typename T>
-    class tensor<T, 1>
+    template <typename T, typename Alloc>
+    class tensor<T, 1, Alloc>
     {
         public:
-            explicit tensor(size_t size = 3);
+            using value_type = T;
+            static constexpr size_t rank = 1;
+
+            explicit tensor(size_t size = 3, const Alloc& alloc = Alloc());
+
+            template <typename E>
+            requires is_tensor_expression_v<E> && (tensor_rank_v<E> == 1)
+            tensor(const E& e, const Alloc& alloc = Alloc());
+
+            template <typename E>
+            requires is_tensor_expression_v<E> && (tensor_rank_v<E> == 1)
+            tensor& operator=(const E& e);
 
             T& operator[](size_t k);
             const T& operator[](size_t k) const;
@@ -53,61 +244,247 @@ namespace monster
                 return elements.size();
             }
 
+            T* data()
+            {
+                return elements.data();
+            }
+
+            const T* data() const
+            {
+                return elements.data();
+            }
+
+            Alloc get_allocator() const
+            {
+                return Alloc(elements.get_allocator());
+            }
+
             virtual ~tensor() = default;
 
         private:
-            std::vector<T> elements;
+            std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>> elements;
     };
 
-    template <typename T, size_t N>
-    tensor<T, N>::tensor(size_t size)
+    template <typename T, size_t N, typename Alloc>
+    tensor<T, N, Alloc>::tensor(size_t size, const Alloc& alloc) : elements(alloc)
     {
         resize(size);
     }
 
-    template <typename T, size_t N>
-    void tensor<T, N>::resize(size_t size)
+    template <typename T, size_t N, typename Alloc>
+    template <typename E>
+    requires is_tensor_expression_v<E> && (tensor_rank_v<E> == N)
+    tensor<T, N, Alloc>::tensor(const E& e, const Alloc& alloc) : elements(alloc)
     {
-        elements.resize(size);
+        *this = e;
+    }
+
+    template <typename T, size_t N, typename Alloc>
+    template <typename E>
+    requires is_tensor_expression_v<E> && (tensor_rank_v<E> == N)
+    tensor<T, N, Alloc>& tensor<T, N, Alloc>::operator=(const E& e)
+    {
+        if (size() != e.size())
+            resize(e.size());
+        for (size_t k = 0; k != elements.size(); ++k)
+             elements[k] = e[k];
+        return *this;
+    }
+
+    template <typename T, size_t N, typename Alloc>
+    void tensor<T, N, Alloc>::resize(size_t size)
+    {
+        if (size < elements.size())
+            elements.erase(elements.begin() + size, elements.end());
+
         for (auto& element : elements)
              element.resize(size);
+
+        elements.reserve(size);
+        while (elements.size() < size)
+               elements.emplace_back(size, get_allocator());
     }
 
-    template <typename T, size_t N>
-    tensor<T, N-1>& tensor<T, N>::operator[](size_t k)
+    // only the outermost dimension is built here, for_each(n, g) must call g(k) for every k in [0, n)
+    // to build the sub-tensors, possibly on other threads so their memory is first touched there
+    template <typename T, size_t N, typename Alloc>
+    template <typename F>
+    void tensor<T, N, Alloc>::resize(size_t size, F&& for_each)
+    {
+        if (size < elements.size())
+            elements.erase(elements.begin() + size, elements.end());
+
+        elements.reserve(size);
+        while (elements.size() < size)
+               elements.emplace_back(0, get_allocator());
+
+        for_each(size, [this, size](size_t k){ elements[k].resize(size); });
+    }
+
+    template <typename T, size_t N, typename Alloc>
+    tensor<T, N-1, Alloc>& tensor<T, N, Alloc>::operator[](size_t k)
     {
         return elements[k];
     }
 
-    template <typename T, size_t N>
-    const tensor<T, N-1>& tensor<T, N>::operator[](size_t k) const
+    template <typename T, size_t N, typename Alloc>
+    const tensor<T, N-1, Alloc>& tensor<T, N, Alloc>::operator[](size_t k) const
     {
         return elements[k];
     }
 
-    template <typename T>
-    tensor<T, 1>::tensor(size_t size)
+    template <typename T, typename Alloc>
+    tensor<T, 1, Alloc>::tensor(size_t size, const Alloc& alloc) : elements(alloc)
     {
         resize(size);
     }
 
-    template <typename T>
-    void tensor<T, 1>::resize(size_t size)
+    template <typename T, typename Alloc>
+    template <typename E>
+    requires is_tensor_expression_v<E> && (tensor_rank_v<E> == 1)
+    tensor<T, 1, Alloc>::tensor(const E& e, const Alloc& alloc) : elements(alloc)
+    {
+        *this = e;
+    }
+
+    template <typename T, typename Alloc>
+    template <typename E>
+    requires is_tensor_expression_v<E> && (tensor_rank_v<E> == 1)
+    tensor<T, 1, Alloc>& tensor<T, 1, Alloc>::operator=(const E& e)
+    {
+        auto n = e.size();
+        elements.resize(n);
+        for (size_t k = 0; k != n; ++k)
+             elements[k] = e[k];
+        return *this;
+    }
+
+    template <typename T, typename Alloc>
+    void tensor<T, 1, Alloc>::resize(size_t size)
     {
         elements.resize(size);
     }
 
-    template <typename T>
-    T& tensor<T, 1>::operator[](size_t k)
+    template <typename T, typename Alloc>
+    T& tensor<T, 1, Alloc>::operator[](size_t k)
     {
         return elements[k];
     }
 
-    template <typename T>
-    const T& tensor<T, 1>::operator[](size_t k) const
+    template <typename T, typename Alloc>
+    const T& tensor<T, 1, Alloc>::operator[](size_t k) const
     {
         return elements[k];
     }
+
+    template <typename T, size_t N, typename Alloc, typename F>
+    void tensor_for_each_row(const tensor<T, N, Alloc>& t, F&& f)
+    {
+        if constexpr(N == 1)
+            f(t.data(), t.size());
+        else
+            for (size_t k = 0; k != t.size(); ++k)
+                 tensor_for_each_row(t[k], f);
+    }
+
+    template <typename T, size_t N, typename Alloc, typename F>
+    void tensor_for_each_row(tensor<T, N, Alloc>& t, F&& f)
+    {
+        if constexpr(N == 1)
+            f(t.data(), t.size());
+        else
+            for (size_t k = 0; k != t.size(); ++k)
+                 tensor_for_each_row(t[k], f);
+    }
+
+    template <typename L, typename R>
+    concept tensor_arithmetic = (tensor_operand<L> && tensor_operand<R> && tensor_rank_v<L> == tensor_rank_v<R>) ||
+                                (tensor_operand<L> && !tensor_operand<R> && std::convertible_to<R, tensor_value_t<L>>) ||
+                                (!tensor_operand<L> && tensor_operand<R> && std::convertible_to<L, tensor_value_t<R>>);
+
+    // a scalar keeps its own type, so the operator promotes it with the element as usual
+    template <typename T, typename U>
+    decltype(auto) make_tensor_operand(const T& t)
+    {
+        if constexpr(tensor_operand<T>)
+            return t;
+        else
+            return tensor_scalar<T, tensor_rank_v<U>>(t);
+    }
+
+    template <typename F, typename L, typename R>
+    auto make_tensor_binary(const L& lhs, const R& rhs)
+    {
+        using U = std::conditional_t<tensor_operand<L>, L, R>;
+
+        using lhs_t = std::remove_cvref_t<decltype(make_tensor_operand<L, U>(lhs))>;
+        using rhs_t = std::remove_cvref_t<decltype(make_tensor_operand<R, U>(rhs))>;
+
+        return tensor_binary<F, lhs_t, rhs_t>(make_tensor_operand<L, U>(lhs), make_tensor_operand<R, U>(rhs));
+    }
+
+    template <typename L, typename R>
+    requires tensor_arithmetic<L, R>
+    auto operator+(const L& lhs, const R& rhs)
+    {
+        return make_tensor_binary<std::plus<>>(lhs, rhs);
+    }
+
+    template <typename L, typename R>
+    requires tensor_arithmetic<L, R>
+    auto operator-(const L& lhs, const R& rhs)
+    {
+        return make_tensor_binary<std::minus<>>(lhs, rhs);
+    }
+
+    template <typename L, typename R>
+    requires tensor_arithmetic<L, R>
+    auto operator*(const L& lhs, const R& rhs)
+    {
+        return make_tensor_binary<std::multiplies<>>(lhs, rhs);
+    }
+
+    template <typename L, typename R>
+    requires tensor_arithmetic<L, R>
+    auto operator/(const L& lhs, const R& rhs)
+    {
+        return make_tensor_binary<std::divides<>>(lhs, rhs);
+    }
+
+    template <typename E>
+    requires tensor_operand<E>
+    auto operator-(const E& e)
+    {
+        return tensor_unary<std::negate<>, E>(e);
+    }
+
+    template <typename T, size_t N, typename Alloc, typename E>
+    requires tensor_arithmetic<tensor<T, N, Alloc>, E>
+    tensor<T, N, Alloc>& operator+=(tensor<T, N, Alloc>& t, const E& e)
+    {
+        return t = t + e;
+    }
+
+    template <typename T, size_t N, typename Alloc, typename E>
+    requires tensor_arithmetic<tensor<T, N, Alloc>, E>
+    tensor<T, N, Alloc>& operator-=(tensor<T, N, Alloc>& t, const E& e)
+    {
+        return t = t - e;
+    }
+
+    template <typename T, size_t N, typename Alloc, typename E>
+    requires tensor_arithmetic<tensor<T, N, Alloc>, E>
+    tensor<T, N, Alloc>& operator*=(tensor<T, N, Alloc>& t, const E& e)
+    {
+        return t = t * e;
+    }
+
+    template <typename T, size_t N, typename Alloc, typename E>
+    requires tensor_arithmetic<tensor<T, N, Alloc>, E>
+    tensor<T, N, Alloc>& operator/=(tensor<T, N, Alloc>& t, const E& e)
+    {
+        return t = t / e;
+    }
 }
 
 #endif
@@ -0,0 +1,450 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+#ifndef TENSOR_IO_HPP
+#define TENSOR_IO_HPP
+
+#include <array>
+#include <memory>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tensor.hpp"
+
+// On-disk layout of a tensor file, all integers are stored in native byte order:
+//
+//     char     magic[8]        "MONSTER"
+//     uint32_t endian          0x01020304, rejects files written on a machine of different byte order
+//     uint32_t dtype           tensor_dtype of the elements
+//     uint32_t element_size    sizeof(T)
+//     uint32_t rank            N
+//     uint64_t offset          byte offset of the first element, a multiple of 64
+//     uint64_t shape[N]
+//     uint64_t strides[N]      in elements, row-major
+//
+// The elements follow at offset as raw contiguous data, so a file can be mapped and used in place.
+
+namespace monster
+{
+    enum class tensor_dtype : uint32_t
+    {
+        opaque, int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64
+    };
+
+    template <typename T>
+    constexpr tensor_dtype dtype_of()
+    {
+        if constexpr(std::is_floating_point_v<T> && sizeof(T) == 4)
+            return tensor_dtype::float32;
+        else if constexpr(std::is_floating_point_v<T> && sizeof(T) == 8)
+            return tensor_dtype::float64;
+        else if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+        {
+            constexpr auto s = std::is_signed_v<T>;
+            switch (sizeof(T))
+            {
+                case 1: return s ? tensor_dtype::int8 : tensor_dtype::uint8;
+                case 2: return s ? tensor_dtype::int16 : tensor_dtype::uint16;
+                case 4: return s ? tensor_dtype::int32 : tensor_dtype::uint32;
+                case 8: return s ? tensor_dtype::int64 : tensor_dtype::uint64;
+            }
+        }
+        return tensor_dtype::opaque;
+    }
+
+    template <typename T, size_t N>
+    struct tensor_header
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "tensor_io requires trivially copyable elements");
+
+        static constexpr char magic[8] = {'M', 'O', 'N', 'S', 'T', 'E', 'R', '\0'};
+        static constexpr uint32_t endian = 0x01020304;
+
+        static constexpr size_t prefix = 32;
+        static constexpr size_t size = prefix + 2 * N * sizeof(uint64_t);
+        static constexpr size_t offset = (size + 63) / 64 * 64;
+
+        std::array<size_t, N> shape;
+        std::array<size_t, N> strides;
+
+        explicit tensor_header(const std::array<size_t, N>& shape) : shape(shape)
+        {
+            size_t stride = 1;
+            for (size_t i = N; i != 0; --i)
+            {
+                 strides[i - 1] = stride;
+                 stride *= shape[i - 1];
+            }
+        }
+
+        size_t count() const
+        {
+            return strides[0] * shape[0];
+        }
+
+        void write(std::ostream& os) const
+        {
+            char buf[offset] = {};
+
+            std::memcpy(buf, magic, sizeof(magic));
+            auto p = buf + sizeof(magic);
+
+            for (uint32_t v : {endian, static_cast<uint32_t>(dtype_of<T>()), static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(N)})
+            {
+                 std::memcpy(p, &v, sizeof(v));
+                 p += sizeof(v);
+            }
+
+            uint64_t o = offset;
+            std::memcpy(p, &o, sizeof(o));
+            p += sizeof(o);
+
+            for (auto& dims : {shape, strides})
+                 for (uint64_t v : dims)
+                 {
+                      std::memcpy(p, &v, sizeof(v));
+                      p += sizeof(v);
+                 }
+
+            if (!os.write(buf, offset))
+                throw std::runtime_error("tensor_header: write failed");
+        }
+
+        static tensor_header parse(const char* buf, size_t len)
+        {
+            if (len < size || std::memcmp(buf, magic, sizeof(magic)))
+                throw std::runtime_error("tensor_header: not a tensor file");
+
+            uint32_t fields[4];
+            uint64_t off;
+
+            std::memcpy(fields, buf + sizeof(magic), sizeof(fields));
+            std::memcpy(&off, buf + sizeof(magic) + sizeof(fields), sizeof(off));
+
+            if (fields[0] != endian)
+                throw std::runtime_error("tensor_header: byte order mismatch");
+            if (fields[1] != static_cast<uint32_t>(dtype_of<T>()) || fields[2] != sizeof(T))
+                throw std::runtime_error("tensor_header: element type mismatch");
+            if (fields[3] != N)
+                throw std::runtime_error("tensor_header: rank mismatch");
+            if (off != offset)
+                throw std::runtime_error("tensor_header: offset mismatch");
+
+            std::array<size_t, N> shape;
+            auto p = buf + prefix;
+
+            for (auto& v : shape)
+            {
+                 uint64_t d;
+                 std::memcpy(&d, p, sizeof(d));
+                 v = d;
+                 p += sizeof(d);
+            }
+
+            // every stride and the byte size are products of the extents, none of them may wrap
+            size_t bytes = sizeof(T);
+            for (auto v : shape)
+            {
+                 if (v && bytes > std::numeric_limits<size_t>::max() / v)
+                     throw std::runtime_error("tensor_header: shape overflow");
+                 bytes *= v ? v : 1;
+            }
+
+            tensor_header header(shape);
+            for (auto& v : header.strides)
+            {
+                 uint64_t d;
+                 std::memcpy(&d, p, sizeof(d));
+                 if (v != d)
+                     throw std::runtime_error("tensor_header: unsupported strides");
+                 p += sizeof(d);
+            }
+
+            return header;
+        }
+
+        static tensor_header read(std::istream& is)
+        {
+            char buf[offset];
+            if (!is.read(buf, offset))
+                throw std::runtime_error("tensor_header: read failed");
+            return parse(buf, offset);
+        }
+    };
+
+    // A read-only, non-owning strided view over contiguous tensor data.
+    template <typename T, size_t N>
+    class tensor_view
+    {
+        public:
+            using value_type = T;
+            static constexpr size_t rank = N;
+
+            tensor_view(const T* data, const std::array<size_t, N>& shape, const std::array<size_t, N>& strides) :
+            ptr(data), dims(shape), steps(strides)
+            {
+            }
+
+            decltype(auto) operator[](size_t k) const
+            {
+                if constexpr(N == 1)
+                    return static_cast<const T&>(ptr[k * steps[0]]);
+                else
+                    return tensor_view<T, N - 1>(ptr + k * steps[0], tail(dims), tail(steps));
+            }
+
+            size_t size() const
+            {
+                return dims[0];
+            }
+
+            const T* data() const
+            {
+                return ptr;
+            }
+
+            const std::array<size_t, N>& shape() const
+            {
+                return dims;
+            }
+
+            const std::array<size_t, N>& strides() const
+            {
+                return steps;
+            }
+
+        private:
+            static std::array<size_t, N - 1> tail(const std::array<size_t, N>& a)
+            {
+                std::array<size_t, N - 1> t;
+                std::copy(a.begin() + 1, a.end(), t.begin());
+                return t;
+            }
+
+            const T* ptr;
+            std::array<size_t, N> dims;
+            std::array<size_t, N> steps;
+    };
+
+    template <typename T, size_t N>
+    struct is_tensor_expression<tensor_view<T, N>> : std::true_type
+    {
+    };
+
+    // Writes a tensor file chunk by chunk, the total number of elements is fixed by the shape.
+    template <typename T, size_t N>
+    class tensor_writer
+    {
+        public:
+            tensor_writer(std::ostream& os, const std::array<size_t, N>& shape) : os(os), header(shape), left(header.count())
+            {
+                header.write(os);
+            }
+
+            void write(const T* data, size_t count)
+            {
+                if (count > left)
+                    throw std::length_error("tensor_writer: too many elements");
+                if (!os.write(reinterpret_cast<const char*>(data), count * sizeof(T)))
+                    throw std::runtime_error("tensor_writer: write failed");
+                left -= count;
+            }
+
+            size_t remaining() const
+            {
+                return left;
+            }
+
+            const std::array<size_t, N>& shape() const
+            {
+                return header.shape;
+            }
+
+        private:
+            std::ostream& os;
+            tensor_header<T, N> header;
+            size_t left;
+    };
+
+    // Reads a tensor file chunk by chunk in bounded memory.
+    template <typename T, size_t N>
+    class tensor_reader
+    {
+        public:
+            explicit tensor_reader(std::istream& is) : is(is), header(tensor_header<T, N>::read(is)), left(header.count())
+            {
+            }
+
+            size_t read(T* data, size_t count)
+            {
+                count = std::min(count, left);
+                if (!is.read(reinterpret_cast<char*>(data), count * sizeof(T)))
+                    throw std::runtime_error("tensor_reader: truncated file");
+                left -= count;
+                return count;
+            }
+
+            size_t remaining() const
+            {
+                return left;
+            }
+
+            const std::array<size_t, N>& shape() const
+            {
+                return header.shape;
+            }
+
+        private:
+            std::istream& is;
+            tensor_header<T, N> header;
+            size_t left;
+    };
+
+    template <typename T, size_t N, typename Alloc>
+    void tensor_save(const tensor<T, N, Alloc>& t, std::ostream& os)
+    {
+        std::array<size_t, N> shape;
+        shape.fill(t.size());
+
+        tensor_writer<T, N> writer(os, shape);
+        tensor_for_each_row(t, [&](const T* row, size_t n){ writer.write(row, n); });
+    }
+
+    template <typename T, size_t N, typename Alloc>
+    void tensor_save(const tensor<T, N, Alloc>& t, const std::string& path)
+    {
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        if (!os)
+            throw std::runtime_error("tensor_save: cannot open " + path);
+        tensor_save(t, os);
+    }
+
+    template <typename T, size_t N, typename Alloc>
+    void tensor_load(tensor<T, N, Alloc>& t, std::istream& is)
+    {
+        tensor_reader<T, N> reader(is);
+        auto& shape = reader.shape();
+
+        for (auto d : shape)
+             if (d != shape[0])
+                 throw std::runtime_error("tensor_load: tensor requires equal extents");
+
+        t.resize(shape[0]);
+        tensor_for_each_row(t, [&](T* row, size_t n){ reader.read(row, n); });
+    }
+
+    template <typename T, size_t N, typename Alloc>
+    void tensor_load(tensor<T, N, Alloc>& t, const std::string& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        if (!is)
+            throw std::runtime_error("tensor_load: cannot open " + path);
+        tensor_load(t, is);
+    }
+
+    // Maps a tensor file read-only into memory, the view refers directly to the mapped pages.
+    template <typename T, size_t N>
+    class mapped_tensor
+    {
+        public:
+            explicit mapped_tensor(const std::string& path)
+            {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    throw std::system_error(errno, std::generic_category(), "mapped_tensor: open " + path);
+
+                struct stat st;
+                if (::fstat(fd, &st) < 0)
+                {
+                    auto e = errno;
+                    ::close(fd);
+                    throw std::system_error(e, std::generic_category(), "mapped_tensor: fstat " + path);
+                }
+
+                len = st.st_size;
+                if (len == 0)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("mapped_tensor: empty file " + path);
+                }
+
+                addr = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+
+                auto e = errno;
+                ::close(fd);
+
+                if (addr == MAP_FAILED)
+                    throw std::system_error(e, std::generic_category(), "mapped_tensor: mmap " + path);
+
+                try
+                {
+                    auto header = tensor_header<T, N>::parse(static_cast<const char*>(addr), len);
+                    // a crafted header can make offset + count * sizeof(T) wrap, so neither side is multiplied
+                    if (header.offset > len || header.count() > (len - header.offset) / sizeof(T))
+                        throw std::runtime_error("mapped_tensor: truncated file");
+
+                    auto data = reinterpret_cast<const T*>(static_cast<const char*>(addr) + header.offset);
+                    view_ = std::make_unique<tensor_view<T, N>>(data, header.shape, header.strides);
+                }
+                catch (...)
+                {
+                    ::munmap(addr, len);
+                    throw;
+                }
+            }
+
+            mapped_tensor(const mapped_tensor&) = delete;
+            mapped_tensor& operator=(const mapped_tensor&) = delete;
+
+            mapped_tensor(mapped_tensor&& other) noexcept :
+            addr(std::exchange(other.addr, MAP_FAILED)), len(std::exchange(other.len, 0)), view_(std::move(other.view_))
+            {
+            }
+
+            mapped_tensor& operator=(mapped_tensor&&) = delete;
+
+            const tensor_view<T, N>& view() const
+            {
+                return *view_;
+            }
+
+            decltype(auto) operator[](size_t k) const
+            {
+                return (*view_)[k];
+            }
+
+            size_t size() const
+            {
+                return view_->size();
+            }
+
+            virtual ~mapped_tensor()
+            {
+                if (addr != MAP_FAILED)
+                    ::munmap(addr, len);
+            }
+
+        private:
+            void* addr = MAP_FAILED;
+            size_t len = 0;
+            std::unique_ptr<tensor_view<T, N>> view_;
+    };
+}
+
+#endif
@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2016-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/monster
+//
+
+#ifndef TENSOR_PARALLEL_HPP
+#define TENSOR_PARALLEL_HPP
+
+#include <memory>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include "tensor.hpp"
+#include "thread_pool.hpp"
+
+// The outermost dimension is split into one contiguous block of sub-tensors per worker of the pool
+// by thread_pool::parallel_for. The blocks are the same for every call with the same pool and extent,
+// so a tensor built by parallel_resize is later filled, transformed and scanned by the threads that
+// first touched its pages, which keeps the memory local to their NUMA node and their caches warm.
+// Only allocators that may be used from any thread build the sub-tensors on the workers, the others
+// allocate on the calling thread, and no helper below allocates once the workers are running.
+
+namespace monster
+{
+    // stateless allocators draw from the global heap, stateful ones such as arena_allocator or a
+    // std::pmr::polymorphic_allocator may wrap an unsynchronized resource, specialize for a thread-safe one
+    template <typename Alloc>
+    struct is_concurrent_allocator : std::allocator_traits<Alloc>::is_always_equal
+    {
+    };
+
+    template <typename Alloc>
+    inline constexpr auto is_concurrent_allocator_v = is_concurrent_allocator<Alloc>::value;
+
+    template <typename T, size_t N, typename Alloc>
+    void parallel_resize(thread_pool& pool, tensor<T, N, Alloc>& t, size_t size)
+    {
+        if constexpr(N == 1 || !is_concurrent_allocator_v<Alloc>)
+            t.resize(size);
+        else
+            t.resize(size, [&pool](size_t n, auto&& f){ pool.parallel_for(0, n, f); });
+    }
+
+    template <typename T, size_t N, typename Alloc, typename U>
+    void parallel_fill(thread_pool& pool, tensor<T, N, Alloc>& t, const U& value)
+    {
+        if constexpr(N == 1)
+            pool.parallel_for(0, t.size(), [&](size_t k){ t[k] = value; });
+        else
+            pool.parallel_for(0, t.size(), [&](size_t k)
+            {
+                tensor_for_each_row(t[k], [&](T* row, size_t n){ std::fill(row, row + n, value); });
+            });
+    }
+
+    template <typename E, typename T, size_t N, typename Alloc, typename F>
+    void tensor_transform(const E& e, tensor<T, N, Alloc>& t, F& f)
+    {
+        for (size_t k = 0; k != t.size(); ++k)
+        {
+             if constexpr(N == 1)
+                 t[k] = f(e[k]);
+             else
+                 tensor_transform(e[k], t[k], f);
+        }
+    }
+
+    // t may be the source tensor itself, src can be any tensor expression of the same rank
+    template <typename E, typename T, size_t N, typename Alloc, typename F>
+    requires tensor_operand<E> && (tensor_rank_v<E> == N)
+    void parallel_transform(thread_pool& pool, const E& src, tensor<T, N, Alloc>& t, F f)
+    {
+        if (t.size() != src.size())
+            parallel_resize(pool, t, src.size());
+
+        if constexpr(N == 1)
+            pool.parallel_for(0, t.size(), [&](size_t k){ t[k] = f(src[k]); });
+        else
+            pool.parallel_for(0, t.size(), [&](size_t k){ tensor_transform(src[k], t[k], f); });
+    }
+
+    template <typename T, size_t N, typename Alloc, typename F>
+    void parallel_transform(thread_pool& pool, tensor<T, N, Alloc>& t, F f)
+    {
+        parallel_transform(pool, t, t, f);
+    }
+
+    template <typename E, typename R, typename F>
+    void tensor_reduce(const E& e, std::optional<R>& acc, F& op)
+    {
+        for (size_t k = 0; k != e.size(); ++k)
+        {
+             if constexpr(tensor_rank_v<E> == 1)
+                 acc = acc ? op(std::move(*acc), e[k]) : R(e[k]);
+             else
+                 tensor_reduce(e[k], acc, op);
+        }
+    }
+
+    // op must be associative, the partial results of the sub-tensors are combined in order
+    template <typename E, typename R, typename F = std::plus<>>
+    requires tensor_operand<E>
+    R parallel_reduce(thread_pool& pool, const E& e, R init, F op = F())
+    {
+        std::vector<std::optional<R>> partials;
+
+        if constexpr(tensor_rank_v<E> == 1)
+        {
+            size_t n = e.size();
+            size_t blocks = std::min(n, std::max(pool.size(), size_t(1)));
+
+            partials.resize(blocks);
+            pool.parallel_for(0, blocks, [&](size_t b)
+            {
+                auto& acc = partials[b];
+                for (size_t k = n * b / blocks; k != n * (b + 1) / blocks; ++k)
+                     acc = acc ? op(std::move(*acc), e[k]) : R(e[k]);
+            });
+        }
+        else
+        {
+            partials.resize(e.size());
+            pool.parallel_for(0, e.size(), [&](size_t k){ tensor_reduce(e[k], partials[k], op); });
+        }
+
+        for (auto& partial : partials)
+             if (partial)
+                 init = op(std::move(init), std::move(*partial));
+
+        return init;
+    }
+}
+
+#endif
@@ -16,6 +16,7 @@
 #include <memory>
 #include <thread>
 #include <vector>
+#include <algorithm>
 #include <functional>
 #include <type_traits>
 #include <condition_variable>
@@ -30,6 +31,17 @@ namespace monster
             template <typename F, typename... Args>
             auto post(F&& f, Args&&... args);
 
+            // block b of [first, last) always runs on worker b, so the same thread keeps touching the same
+            // part of the data across calls with the same extent, a call from one of this pool's own workers
+            // runs inline, it would otherwise wait on blocks queued behind the very tasks that are waiting
+            template <typename F>
+            void parallel_for(size_t first, size_t last, F&& f);
+
+            size_t size() const
+            {
+                return workers.size();
+            }
+
             ~thread_pool();
 
         private:
@@ -38,23 +50,33 @@ namespace monster
             std::condition_variable cond;
             std::vector<std::thread> workers;
             std::queue<std::function<void()>> tasks;
+            std::vector<std::queue<std::function<void()>>> pinned;
+
+            // the pool the calling thread works for, if any
+            static inline thread_local const thread_pool* current = nullptr;
     };
 
-    thread_pool::thread_pool(size_t size)
+    inline thread_pool::thread_pool(size_t size) : pinned(size)
     {
         for (size_t i = 0; i != size; ++i)
-             workers.emplace_back([this]
+             workers.emplace_back([this, i]
              {
+                 current = this;
+                 auto& own = pinned[i];
+
                  while (true)
                  {
                      std::function<void()> task;
                      {
                          std::unique_lock<std::mutex> lock(mutex);
-                         cond.wait(lock, [this]{ return stop || !tasks.empty(); });
-                         if (stop && tasks.empty())
+                         cond.wait(lock, [&]{ return stop || !own.empty() || !tasks.empty(); });
+                         if (stop && own.empty() && tasks.empty())
                              return;
-                         task = std::move(tasks.front());
-                         tasks.pop();
+
+                         // blocks pinned to this worker go first
+                         auto& queue = own.empty() ? tasks : own;
+                         task = std::move(queue.front());
+                         queue.pop();
                      }
                      task();
                  }
@@ -75,7 +97,52 @@ namespace monster
         return fut;
     }
 
-    thread_pool::~thread_pool()
+    // splits [first, last) into one contiguous block per worker, f is invoked with every index and exceptions are rethrown
+    template <typename F>
+    void thread_pool::parallel_for(size_t first, size_t last, F&& f)
+    {
+        if (first >= last)
+            return;
+
+        size_t n = last - first;
+        size_t blocks = std::min(n, std::max(size(), size_t(1)));
+
+        if (blocks == 1 || workers.empty() || current == this)
+        {
+            for (size_t i = first; i != last; ++i)
+                 f(i);
+            return;
+        }
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(blocks);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (size_t b = 0; b != blocks; ++b)
+            {
+                 size_t begin = first + n * b / blocks;
+                 size_t end = first + n * (b + 1) / blocks;
+
+                 auto task = std::make_shared<std::packaged_task<void()>>([&f, begin, end]
+                 {
+                     for (size_t i = begin; i != end; ++i)
+                          f(i);
+                 });
+
+                 futures.emplace_back(task->get_future());
+                 pinned[b].emplace([task]{ (*task)(); });
+            }
+        }
+        // every worker checks its own queue, a single notification might wake one without a block
+        cond.notify_all();
+
+        for (auto& fut : futures)
+             fut.wait();
+        for (auto& fut : futures)
+             fut.get();
+    }
+
+    inline thread_pool::~thread_pool()
     {
         {
             std::unique_lock<std::mutex> lock(mutex);